@@ -0,0 +1,144 @@
+//
+// Created by cew05 on 19/10/2026.
+//
+
+/*
+ * chess_render_bench: drives the render path without a display. The window is created on SDL's offscreen video driver
+ * with a software renderer, then each scripted position is displayed for a number of frames, with the resize path
+ * exercised at a fixed interval. Prints frames/sec and p50/p99 per phase.
+ *
+ * usage: chess_render_bench [frames per position] [resize interval] [positions file, one FEN per line]
+ */
+
+#define SDL_MAIN_HANDLED
+#include <SDL.h>
+#include <SDL_ttf.h>
+
+#include <string>
+#include <vector>
+#include <fstream>
+
+#include "../src_headers/GlobalSource.h"
+#include "../src_headers/GlobalResources.h"
+#include "../UserInterface/include/GameScreen.h"
+
+// Openings, middlegames and endgames so piece count varies
+const std::vector<std::string> BENCH_POSITIONS = {
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+        "r1bqkb1r/pppp1ppp/2n2n2/4p3/2B1P3/5N2/PPPP1PPP/RNBQK2R w KQkq - 4 4",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "8/8/4k3/8/8/3K4/8/8 w - - 0 1",
+};
+
+// Window sizes cycled through by the resize path
+const std::vector<std::pair<int, int>> BENCH_SIZES = {
+        {900, 540}, {1280, 720}, {1920, 1080}, {1024, 768},
+};
+
+int main(int argc, char** argv) {
+    int framesPerPosition = (argc > 1) ? std::max(std::stoi(argv[1]), 1) : 300;
+    int resizeInterval = (argc > 2) ? std::max(std::stoi(argv[2]), 0) : 60;
+
+    std::vector<std::string> positions = BENCH_POSITIONS;
+    if (argc > 3) {
+        std::ifstream positionsFile(argv[3]);
+        std::string fen;
+        positions.clear();
+        while (std::getline(positionsFile, fen)) {
+            if (!fen.empty()) positions.push_back(fen);
+        }
+    }
+
+    // Headless SDL, no display or GPU required
+    SDL_SetHint(SDL_HINT_VIDEODRIVER, "offscreen");
+    if (SDL_Init(SDL_INIT_VIDEO) != 0) {
+        LogError("Issue initialising SDL", SDL_GetError(), true);
+        return 1;
+    }
+    if (TTF_Init() != 0) {
+        LogError("TTF failed to init", SDL_GetError(), true);
+        return 1;
+    }
+
+    window.currentRect = {0, 0, BENCH_SIZES[0].first, BENCH_SIZES[0].second};
+    window.minRect = window.currentRect;
+    window.window = SDL_CreateWindow("ChesSDL Bench", 0, 0, window.currentRect.w, window.currentRect.h,
+                                     SDL_WINDOW_HIDDEN);
+    window.renderer = SDL_CreateRenderer(window.window, -1, SDL_RENDERER_SOFTWARE | SDL_RENDERER_TARGETTEXTURE);
+    if (!window.window || !window.renderer) {
+        LogError("Failed to create offscreen window", SDL_GetError(), true);
+        return 1;
+    }
+
+    // Same resources as the game
+    InitFonts();
+    InitTextures();
+    SetStyles();
+
+    GameScreen gs('W');
+    gs.ResizeScreen();
+    gs.CreateTextures();
+    currentScreen = &gs;
+
+    /*
+     * BENCH LOOP
+     */
+
+    int totalFrames = 0, sizeIndex = 0;
+    Uint64 benchStart = SDL_GetPerformanceCounter();
+
+    for (const std::string& fen : positions) {
+        if (!gs.SetUpPiecesFromFEN(fen)) continue;
+
+        for (int f = 0; f < framesPerPosition; f++) {
+            frameTick.lastTick = frameTick.currTick;
+            frameTick.currTick = SDL_GetTicks64();
+            frameTick.tickChange = frameTick.currTick - frameTick.lastTick;
+            frameProfiler.NextFrame();
+            ProfileScope frameScope(ProfilePhase::FRAME);
+
+            SDL_RenderClear(window.renderer);
+            {
+                ProfileScope scope(ProfilePhase::DISPLAY);
+                gs.Display();
+            }
+
+            // Resize and rebuild, as main does once a resize has settled
+            if (resizeInterval > 0 && f % resizeInterval == resizeInterval - 1) {
+                ProfileScope scope(ProfilePhase::TEXTURES);
+                sizeIndex = (sizeIndex + 1) % (int)BENCH_SIZES.size();
+                SDL_SetWindowSize(window.window, BENCH_SIZES[sizeIndex].first, BENCH_SIZES[sizeIndex].second);
+                window.currentRect.w = BENCH_SIZES[sizeIndex].first;
+                window.currentRect.h = BENCH_SIZES[sizeIndex].second;
+                gs.ResizeScreen();
+                gs.CreateTextures();
+            }
+
+            SDL_RenderPresent(window.renderer);
+            totalFrames++;
+        }
+    }
+
+    double seconds = double(SDL_GetPerformanceCounter() - benchStart) / (double)SDL_GetPerformanceFrequency();
+
+    /*
+     * REPORT
+     */
+
+    printf("positions %zu frames %d seconds %.3f fps %.1f\n", positions.size(), totalFrames, seconds,
+           seconds > 0 ? totalFrames / seconds : 0.0);
+    for (ProfilePhase phase : {ProfilePhase::FRAME, ProfilePhase::DISPLAY, ProfilePhase::TEXTURES}) {
+        std::array<uint32_t, 2> pct = frameProfiler.FetchP50P99(phase);
+        printf("%s p50_us %u p99_us %u\n", FrameProfiler::PhaseName(phase), pct[0], pct[1]);
+    }
+    frameProfiler.ExportCSV();
+
+    delete fontCache;
+    delete textureLoader;
+    TTF_Quit();
+    SDL_Quit();
+
+    return 0;
+}
@@ -0,0 +1,130 @@
+//
+// Created by cew05 on 19/10/2026.
+//
+
+#include "src_headers/FontCache.h"
+#include "src_headers/GlobalSource.h"
+
+FontCache::~FontCache() {
+    if (atlas != nullptr) SDL_DestroyTexture(atlas);
+
+    for (auto& font : fonts) {
+        TTF_CloseFont(font.second);
+    }
+}
+
+TTF_Font* FontCache::FetchFont(const std::string& _path, int _size) {
+    auto it = fonts.find({_path, _size});
+    if (it != fonts.end()) return it->second;
+
+    TTF_Font* font = TTF_OpenFont(_path.c_str(), _size);
+    if (font == nullptr) {
+        LogError("Failed to load font", SDL_GetError(), false);
+        return nullptr;
+    }
+
+    fonts[{_path, _size}] = font;
+    return font;
+}
+
+bool FontCache::CreateGlyphAtlas(const std::string& _path, int _size) {
+    /*
+     * Renders each printable ASCII glyph once and packs them in rows into a single surface, which is uploaded as the
+     * atlas texture. Each glyph keeps the full line height so glyphs can be placed by advance alone.
+     */
+
+    atlasFont = FetchFont(_path, _size);
+    if (atlasFont == nullptr) return false;
+
+    fontHeight = TTF_FontHeight(atlasFont);
+    const int atlasWidth = 1024, padding = 2;
+
+    // Render glyphs and lay them out in rows
+    std::array<SDL_Surface*, lastGlyph - firstGlyph + 1> surfaces {};
+    int x = padding, y = padding;
+    for (int g = 0; g < glyphs.size(); g++) {
+        auto c = Uint16(firstGlyph + g);
+        int minx, maxx, miny, maxy;
+        TTF_GlyphMetrics(atlasFont, c, &minx, &maxx, &miny, &maxy, &glyphs[g].advance);
+
+        surfaces[g] = TTF_RenderGlyph_Blended(atlasFont, c, {255, 255, 255, 255});
+        if (surfaces[g] == nullptr) continue;
+
+        if (x + surfaces[g]->w + padding > atlasWidth) {
+            x = padding;
+            y += fontHeight + padding;
+        }
+        glyphs[g].srcRect = {x, y, surfaces[g]->w, surfaces[g]->h};
+        x += surfaces[g]->w + padding;
+    }
+
+    // Copy glyphs into one surface, keeping their alpha
+    SDL_Surface* atlasSurface = SDL_CreateRGBSurfaceWithFormat(0, atlasWidth, y + fontHeight + padding, 32,
+                                                               SDL_PIXELFORMAT_RGBA32);
+    if (atlasSurface == nullptr) {
+        LogError("Failed to create glyph atlas surface", SDL_GetError(), false);
+        for (SDL_Surface* surface : surfaces) SDL_FreeSurface(surface);
+        return false;
+    }
+    SDL_FillRect(atlasSurface, nullptr, SDL_MapRGBA(atlasSurface->format, 255, 255, 255, 0));
+
+    for (int g = 0; g < glyphs.size(); g++) {
+        if (surfaces[g] == nullptr) continue;
+
+        SDL_SetSurfaceBlendMode(surfaces[g], SDL_BLENDMODE_NONE);
+        SDL_BlitSurface(surfaces[g], nullptr, atlasSurface, &glyphs[g].srcRect);
+        SDL_FreeSurface(surfaces[g]);
+    }
+
+    if (atlas != nullptr) SDL_DestroyTexture(atlas);
+    atlas = SDL_CreateTextureFromSurface(window.renderer, atlasSurface);
+    SDL_FreeSurface(atlasSurface);
+
+    if (atlas == nullptr) {
+        LogError("Failed to create glyph atlas", SDL_GetError(), false);
+        return false;
+    }
+    SDL_SetTextureBlendMode(atlas, SDL_BLENDMODE_BLEND);
+
+    return true;
+}
+
+const FontCache::GlyphInfo* FontCache::FetchGlyph(char _c) const {
+    if (_c < firstGlyph || _c > lastGlyph) _c = '?';
+    return &glyphs[_c - firstGlyph];
+}
+
+int FontCache::GetTextWidth(const std::string& _text, int _height) const {
+    int width = 0;
+    for (char c : _text) {
+        width += FetchGlyph(c)->advance;
+    }
+
+    return int((double)width * _height / fontHeight);
+}
+
+void FontCache::AddText(SpriteBatch& _batch, const std::string& _text, int _x, int _y, int _height,
+                        SDL_Color _colour) const {
+    double sf = (double)_height / fontHeight;
+    double penX = _x;
+
+    for (char c : _text) {
+        const GlyphInfo* glyph = FetchGlyph(c);
+
+        // whitespace has no pixels, only advance
+        if (glyph->srcRect.w > 0 && c != ' ') {
+            SDL_Rect destRect = {int(penX), _y, int(glyph->srcRect.w * sf), int(glyph->srcRect.h * sf)};
+            _batch.Add(glyph->srcRect, destRect, _colour);
+        }
+
+        penX += glyph->advance * sf;
+    }
+}
+
+bool FontCache::RenderText(const std::string& _text, int _x, int _y, int _height, SDL_Color _colour) {
+    if (atlas == nullptr) return false;
+
+    batch.Begin(atlas);
+    AddText(batch, _text, _x, _y, _height, _colour);
+    return batch.Flush();
+}
@@ -0,0 +1,108 @@
+//
+// Created by cew05 on 19/10/2026.
+//
+
+#include "src_headers/FrameProfiler.h"
+#include "src_headers/GlobalResources.h"
+
+#include <algorithm>
+#include <fstream>
+
+const char* FrameProfiler::PhaseName(ProfilePhase _phase) {
+    switch (_phase) {
+        case ProfilePhase::FRAME: return "frame";
+        case ProfilePhase::DISPLAY: return "display";
+        case ProfilePhase::HANDLE_EVENTS: return "handle_events";
+        case ProfilePhase::UPDATE_BUTTONS: return "update_buttons";
+        case ProfilePhase::CHECK_BUTTONS: return "check_buttons";
+        case ProfilePhase::TEXTURES: return "textures";
+        case ProfilePhase::MOVE_GENERATION: return "move_generation";
+        case ProfilePhase::ENGINE_WAIT: return "engine_wait";
+        default: return "unknown";
+    }
+}
+
+void FrameProfiler::Record(ProfilePhase _phase, uint64_t _micros) {
+    // claim a slot, older samples are overwritten once the buffer wraps
+    uint64_t index = head.fetch_add(1, std::memory_order_relaxed);
+    Sample& sample = samples[index % capacity];
+
+    sample.sequence.store(UINT64_MAX, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    sample.frame = frame.load(std::memory_order_relaxed);
+    sample.phase = _phase;
+    sample.micros = uint32_t(std::min(_micros, (uint64_t)UINT32_MAX));
+    sample.sequence.store(index, std::memory_order_release);
+}
+
+std::vector<FrameProfiler::SampleCopy> FrameProfiler::Snapshot(int _maxSamples) {
+    uint64_t end = head.load(std::memory_order_acquire);
+    uint64_t count = std::min<uint64_t>({end, (uint64_t)capacity, (uint64_t)_maxSamples});
+
+    std::vector<SampleCopy> copies;
+    copies.reserve(count);
+
+    for (uint64_t index = end - count; index < end; index++) {
+        const Sample& sample = samples[index % capacity];
+
+        // skip slots being written or already overwritten
+        if (sample.sequence.load(std::memory_order_acquire) != index) continue;
+        SampleCopy copy = {sample.frame, sample.phase, sample.micros};
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sample.sequence.load(std::memory_order_relaxed) != index) continue;
+
+        copies.push_back(copy);
+    }
+
+    return copies;
+}
+
+std::array<uint32_t, 2> FrameProfiler::FetchP50P99(ProfilePhase _phase) {
+    std::vector<uint32_t> values;
+    for (const auto& sample : Snapshot(4096)) {
+        if (sample.phase == _phase) values.push_back(sample.micros);
+    }
+    if (values.empty()) return {0, 0};
+
+    std::sort(values.begin(), values.end());
+    return {values[(values.size() - 1) * 50 / 100], values[(values.size() - 1) * 99 / 100]};
+}
+
+void FrameProfiler::DisplayOverlay() {
+    if (!showOverlay) return;
+
+    // one line per phase, in the top right corner
+    int lineH = 16, lineW = 300, phases = (int)ProfilePhase::PHASE_COUNT;
+    SDL_Rect background = {window.currentRect.w - lineW - 10, 10, lineW, lineH * (phases + 1) + 8};
+
+    SDL_SetRenderDrawColor(window.renderer, 0, 0, 0, 180);
+    SDL_RenderFillRect(window.renderer, &background);
+    SDL_SetRenderDrawColor(window.renderer, 0, 0, 0, 0);
+
+    int x = background.x + 4, y = background.y + 4;
+    fontCache->RenderText("phase  p50us  p99us", x, y, lineH);
+
+    char line[64];
+    for (int p = 0; p < phases; p++) {
+        y += lineH;
+        std::array<uint32_t, 2> pct = FetchP50P99(ProfilePhase(p));
+        snprintf(line, sizeof(line), "%s  %u  %u", PhaseName(ProfilePhase(p)), pct[0], pct[1]);
+        fontCache->RenderText(line, x, y, lineH);
+    }
+}
+
+bool FrameProfiler::ExportCSV() {
+    std::ofstream file(csvPath, std::ios::trunc);
+    if (!file.good()) {
+        printf("Failed to write frame profile to %s\n", csvPath.c_str());
+        return false;
+    }
+
+    file << "frame,phase,micros\n";
+    for (const auto& sample : Snapshot(capacity)) {
+        file << sample.frame << "," << PhaseName(sample.phase) << "," << sample.micros << "\n";
+    }
+
+    printf("Frame profile written to %s\n", csvPath.c_str());
+    return true;
+}
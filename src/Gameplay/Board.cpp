@@ -16,24 +16,38 @@ Board::Board() {
     rm->NewResource(tileRect, RectID::TILE);
 
     // Open textures
-    tm->OpenTexture(BOARD_COMPILED);
-    tm->OpenTexture(PROMO_WHITE_COMPILED);
-    tm->OpenTexture(PROMO_BLACK_COMPILED);
     tm->OpenTexture(TextureID(BOARD_BASE_SECONDARY + BOARD_STYLE.second));
-}
 
-int Board::CreateBoardTexture() {
-    // Open required textures
-    tm->OpenTexture(TextureID(BOARD_BASE + BOARD_STYLE.second));
-    tm->OpenTexture(TextureID(WHITE_TILE + BOARD_STYLE.second));
-    tm->OpenTexture(TextureID(BLACK_TILE + BOARD_STYLE.second));
+    // Cap VRAM held by compiled textures
+    compiledCache.SetBudget(size_t(FetchConfigValue("CompiledTextureCacheMB", 64)) * 1024 * 1024);
+
+    // Moves are batched and flushed by the journal rather than written per move
+    moveJournal.SetFlushPolicy(FetchConfigValue("JournalFlushMoves", 8),
+                               FetchConfigValue("JournalFlushMs", 2000),
+                               FetchConfigValue("JournalSync", 0) != 0);
+    gameRecord.SetKeyframeInterval(FetchConfigValue("GameRecordKeyframeInterval", 16));
+}
 
-    TTF_Font* font = TTF_OpenFont("../Resources/Fonts/CF/TCFR.ttf", 100);
+Board::~Board() {
+    // Write out anything still buffered for the game in progress
+    FlushGameFiles();
+}
 
+int Board::CreateBoardTexture() {
     // Get board tile dimensions, and board rect
     SDL_Rect boardRect;
     SDL_Rect tileRect;
     rm->FetchResource(boardRect, RectID::BOARD);
+    UpdateTileLayout();
+
+    // Reuse the board compiled for this style, size and orientation if there is one
+    CompiledTextureKey key = {CompiledTextureKey::BOARD, BOARD_STYLE.second, 0, boardRect.w, boardRect.h, flipped};
+    if ((compiledBoard = compiledCache.Fetch(key)) != nullptr) return 0;
+
+    // Open required textures
+    tm->OpenTexture(TextureID(BOARD_BASE + BOARD_STYLE.second));
+    tm->OpenTexture(TextureID(WHITE_TILE + BOARD_STYLE.second));
+    tm->OpenTexture(TextureID(BLACK_TILE + BOARD_STYLE.second));
 
     // Create temp textures to draw to
     SDL_Texture* tempTexture;
@@ -65,15 +79,8 @@ int Board::CreateBoardTexture() {
     // Create board grid using the tile textures
     bool whiteTile = false;
 
-    // Determine top left tile size and position
-    tileRect = {0, 0,
-                int(((double)boardRect.w * (1-2*boardBorder)) / columns),
-                int(((double)boardRect.h * (1-2*boardBorder)) / rows)};
-    tileRect.x = (boardRect.w - (columns*tileRect.w)) / 2;
-    tileRect.y = (boardRect.h - (rows*tileRect.h)) / 2;
-
-    // Store tile
-    topLeftTile = {tileRect.x, tileRect.y, tileRect.w, tileRect.h};
+    // Start from the top left tile
+    tileRect = topLeftTile;
 
     // Now draw board grid pattern
     for (int r = 0; r < rows; r++) {
@@ -92,7 +99,8 @@ int Board::CreateBoardTexture() {
         tileRect.y += tileRect.h;
     }
 
-    // Get font for labels
+    // Get font for labels, its metrics are used to place the glyphs
+    TTF_Font* font = fontCache->AccessAtlasFont();
     if (font == nullptr) {
         // exit early on failure
         LogError("Failed to load font", SDL_GetError(), false);
@@ -110,23 +118,16 @@ int Board::CreateBoardTexture() {
     for (int axis = 0; axis < 2; axis++) {
         // Axis == 0 -> rows
         for (int lIndex = 0; lIndex < ((axis == 0) ? rows : columns); lIndex++) {
-            label[0] = (axis == 0) ? char('1' + lIndex) : char('a' + lIndex);
+            // labels run from the bottom left tile, which is h8 when flipped
+            if (axis == 0) label[0] = flipped ? char('8' - lIndex) : char('1' + lIndex);
+            else label[0] = flipped ? char('h' - lIndex) : char('a' + lIndex);
             SDL_Rect labelRect = {tileRect.x, tileRect.y, int(tileRect.w/2), int(tileRect.h/2)};
-            SDL_Surface* surface;
-
-            // Get label texture
-            surface = TTF_RenderText_Blended(font, label.c_str(), {255, 255, 255});
-            tempTexture = SDL_CreateTextureFromSurface(window.renderer, surface);
-            SDL_FreeSurface(surface);
 
-            // fetch ratio between height of label texture and height of tile
-            std::pair<int, int> labelSize;
-            SDL_QueryTexture(tempTexture, nullptr, nullptr, &labelSize.first, &labelSize.second);
-            float heightRatio = (float)labelSize.second / (float)labelRect.h;
+            // fetch ratio between height of the font and height of tile
+            float heightRatio = (float)fontCache->GetFontHeight() / (float)labelRect.h;
 
-            // set height and width to be proportional
-            labelRect.h = labelRect.h;
-            labelRect.w = int((float)labelSize.first / heightRatio);
+            // set width to be proportional
+            labelRect.w = fontCache->GetTextWidth(label, labelRect.h);
 
             // adjust for space above / below the character
             if (axis == 0) labelRect.y -= int(double(TTF_FontHeight(font) - TTF_FontAscent(font)) / heightRatio);
@@ -141,7 +142,7 @@ int Board::CreateBoardTexture() {
             }
 
             // Draw label
-            SDL_RenderCopy(window.renderer, tempTexture, nullptr, &labelRect);
+            fontCache->RenderText(label, labelRect.x, labelRect.y, labelRect.h);
         }
 
         // Reset tile position, set to BL tile and indent
@@ -156,10 +157,10 @@ int Board::CreateBoardTexture() {
     tm->CloseTexture(TextureID(BOARD_BASE + BOARD_STYLE.second));
     tm->CloseTexture(TextureID(WHITE_TILE + BOARD_STYLE.second));
     tm->CloseTexture(TextureID(BLACK_TILE + BOARD_STYLE.second));
-    TTF_CloseFont(font);
 
     // Update compiled board texture
-    tm->UpdateTexture(boardTexture, BOARD_COMPILED);
+    compiledCache.Store(key, boardTexture);
+    compiledBoard = boardTexture;
 
     // reset render target to window
     SDL_SetRenderTarget(window.renderer, nullptr);
@@ -172,21 +173,29 @@ bool Board::CreatePromoMenuTexture() {
      * select from
      */
 
-    // Load textures
-    tm->OpenTexture(TextureID(PROMO_BASE + BOARD_STYLE.second));
-    for (int c = 0; c < 2; c++) {
-        tm->OpenTexture(TextureID(WHITE_QUEEN + PIECE_STYLE.second + c));
-        tm->OpenTexture(TextureID(WHITE_ROOK + PIECE_STYLE.second + c));
-        tm->OpenTexture(TextureID(WHITE_BISHOP + PIECE_STYLE.second + c));
-        tm->OpenTexture(TextureID(WHITE_KNIGHT + PIECE_STYLE.second + c));
-    }
-
     // Temp vars
     SDL_Texture* tempTexture;
     SDL_Rect promoRect = {0, 0, 200, 56};
     SDL_Rect iconRect;
+    TextureID pieceIDs[4] = {WHITE_QUEEN, WHITE_ROOK, WHITE_BISHOP, WHITE_KNIGHT};
+    RectID rectIDs[4] = {RectID::PROMO_QUEEN, RectID::PROMO_ROOK, RectID::PROMO_BISHOP, RectID::PROMO_KNIGHT};
+    bool texturesOpen = false;
 
     for (int col = 0; col < 2; col++){
+        // Menus only depend on the styles, reuse them if already compiled
+        CompiledTextureKey key = {(col == 0) ? CompiledTextureKey::PROMO_WHITE : CompiledTextureKey::PROMO_BLACK,
+                                  BOARD_STYLE.second, PIECE_STYLE.second, promoRect.w, promoRect.h, false};
+        if ((compiledPromo[col] = compiledCache.Fetch(key)) != nullptr) continue;
+
+        // Load textures
+        if (!texturesOpen) {
+            tm->OpenTexture(TextureID(PROMO_BASE + BOARD_STYLE.second));
+            for (int c = 0; c < 2; c++) {
+                for (TextureID pieceID : pieceIDs) tm->OpenTexture(TextureID(pieceID + PIECE_STYLE.second + c));
+            }
+            texturesOpen = true;
+        }
+
         // Create targetable texture for renderer to draw to
         SDL_Texture *promoTexture = SDL_CreateTexture(window.renderer,
                                                       SDL_PIXELFORMAT_RGBA8888,
@@ -204,7 +213,7 @@ bool Board::CreatePromoMenuTexture() {
         }
 
         // Draw base
-        tempTexture = tm->AccessTexture(PROMO_BASE);
+        tempTexture = tm->AccessTexture(TextureID(PROMO_BASE + BOARD_STYLE.second));
         if (SDL_RenderCopy(window.renderer, tempTexture, nullptr, nullptr) != 0) {
             LogError("Failed to draw promoMenu base texture", SDL_GetError(), false);
             return false;
@@ -212,8 +221,6 @@ bool Board::CreatePromoMenuTexture() {
 
         // Draw icons
         iconRect = {promoRect.w / 25, promoRect.h / 7, promoRect.w * 5/25, promoRect.h * 5/7};
-        TextureID pieceIDs[4] = {WHITE_QUEEN, WHITE_ROOK, WHITE_BISHOP, WHITE_KNIGHT};
-        RectID rectIDs[4] = {RectID::PROMO_QUEEN, RectID::PROMO_ROOK, RectID::PROMO_BISHOP, RectID::PROMO_KNIGHT};
         for (int id = 0; id < 4; id++) {
             // fetch icon texture
             if ((tempTexture = tm->AccessTexture(TextureID(pieceIDs[id] + col + PIECE_STYLE.second))) == nullptr) {
@@ -228,18 +235,25 @@ bool Board::CreatePromoMenuTexture() {
                 return false;
             }
 
-            // add iconRect to rectCollection, move to next icon position
-            rm->NewOrUpdateResource(iconRect, rectIDs[id]);
+            // move to next icon position
             iconRect.x += iconRect.w * 6/5;
         }
 
-        // add promoMenu texture to texture collection
-        tm->UpdateTexture(promoTexture, (col == 0) ? PROMO_WHITE_COMPILED : PROMO_BLACK_COMPILED);
+        // add promoMenu texture to the cache
+        compiledCache.Store(key, promoTexture);
+        compiledPromo[col] = promoTexture;
     }
 
     // Reset render target
     SDL_SetRenderTarget(window.renderer, nullptr);
 
+    // Store icon rects, relative to the menu
+    iconRect = {promoRect.w / 25, promoRect.h / 7, promoRect.w * 5/25, promoRect.h * 5/7};
+    for (RectID rectID : rectIDs) {
+        rm->NewOrUpdateResource(iconRect, rectID);
+        iconRect.x += iconRect.w * 6/5;
+    }
+
     // Reposition the promoMenus rect to centre of boardRect
     SDL_Rect boardRect;
     rm->FetchResource(boardRect, RectID::BOARD);
@@ -249,22 +263,21 @@ bool Board::CreatePromoMenuTexture() {
     // update stored promoRect
     rm->ChangeResource(promoRect, RectID::PROMO_MENU);
 
-    // Load textures
-    tm->CloseTexture(TextureID(PROMO_BASE + BOARD_STYLE.second));
-    for (int c = 0; c < 2; c++) {
-        tm->CloseTexture(TextureID(WHITE_QUEEN + PIECE_STYLE.second + c));
-        tm->CloseTexture(TextureID(WHITE_ROOK + PIECE_STYLE.second + c));
-        tm->CloseTexture(TextureID(WHITE_BISHOP + PIECE_STYLE.second + c));
-        tm->CloseTexture(TextureID(WHITE_KNIGHT + PIECE_STYLE.second + c));
+    // Close textures
+    if (texturesOpen) {
+        tm->CloseTexture(TextureID(PROMO_BASE + BOARD_STYLE.second));
+        for (int c = 0; c < 2; c++) {
+            for (TextureID pieceID : pieceIDs) tm->CloseTexture(TextureID(pieceID + PIECE_STYLE.second + c));
+        }
     }
 
     // success
     return true;
 }
 
-void Board::DisplayPromoMenu(const std::unique_ptr<Piece>& _promotingPiece) {
-    int col = _promotingPiece->GetPieceInfoPtr()->colID == 'W' ?  PROMO_WHITE_COMPILED : PROMO_BLACK_COMPILED;
-    SDL_Texture* displayMenu = tm->AccessTexture(col);
+void Board::DisplayPromoMenu(char _colID) {
+    int col = _colID == 'W' ? 0 : 1;
+    SDL_Texture* displayMenu = compiledPromo[col];
     SDL_Rect rect;
     rm->FetchResource(rect, RectID::PROMO_MENU);
 
@@ -277,7 +290,7 @@ void Board::DisplayGameBoard() {
     SDL_Rect rect;
 
     // DisplayToggle Board background
-    texture = tm->AccessTexture(BOARD_COMPILED);
+    texture = compiledBoard;
     rm->FetchResource(rect, RectID::BOARD);
     SDL_RenderCopy(window.renderer, texture, nullptr, &rect);
 
@@ -372,8 +385,40 @@ void Board::GetTileRectFromPosition(SDL_Rect &rect, std::pair<char, int> positio
     // now move first and second to position
     SDL_Rect boardRect;
     rm->FetchResource(boardRect, RectID::BOARD);
-    rect.x += (rect.w * (std::tolower(position.first) - 'a'));
-    rect.y -= (rect.h * (position.second - 1));
+    int file = std::tolower(position.first) - 'a', rank = position.second - 1;
+
+    // mirror both axes when viewed from black's side
+    if (flipped) {
+        file = columns - 1 - file;
+        rank = rows - 1 - rank;
+    }
+
+    rect.x += (rect.w * file);
+    rect.y -= (rect.h * rank);
+}
+
+bool Board::GetSquareFromPixel(std::pair<int, int> _pixel, std::pair<char, int>& _square) const {
+    /*
+     * Inverse of GetTileRectFromPosition. Returns false if the pixel is not over a tile
+     */
+
+    SDL_Rect boardRect;
+    rm->FetchResource(boardRect, RectID::BOARD);
+    if (topLeftTile.w <= 0 || topLeftTile.h <= 0) return false;
+
+    // offset from the top left corner of the grid, in tiles
+    int dx = _pixel.first - (boardRect.x + topLeftTile.x);
+    int dy = _pixel.second - (boardRect.y + topLeftTile.y);
+    if (dx < 0 || dy < 0) return false;
+
+    int col = dx / topLeftTile.w, row = dy / topLeftTile.h;
+    if (col >= columns || row >= rows) return false;
+
+    // top row is rank 8, or rank 1 when flipped
+    int file = flipped ? columns - 1 - col : col;
+    int rank = flipped ? row : rows - 1 - row;
+    _square = {char('a' + file), rank + 1};
+    return true;
 }
 
 void Board::GetBorderedRectFromPosition(SDL_Rect &_rect, std::pair<char, int> _position) const {
@@ -413,6 +458,21 @@ void Board::FillToBounds(int _w, int _h) {
 
     // Update stored rect
     rm->ChangeResource(rect, BOARD);
+
+    // Pieces are placed on the new tiles straight away, the board texture is rebuilt once resizing settles
+    UpdateTileLayout();
+}
+
+void Board::UpdateTileLayout() {
+    SDL_Rect boardRect;
+    rm->FetchResource(boardRect, BOARD);
+
+    // Determine top left tile size and position, relative to the board
+    topLeftTile = {0, 0,
+                   int(((double)boardRect.w * (1-2*boardBorder)) / columns),
+                   int(((double)boardRect.h * (1-2*boardBorder)) / rows)};
+    topLeftTile.x = (boardRect.w - (columns*topLeftTile.w)) / 2;
+    topLeftTile.y = (boardRect.h - (rows*topLeftTile.h)) / 2;
 }
 
 /*
@@ -440,69 +500,17 @@ bool Board::GameDataDirectoryExists() {
 
 void Board::ClearExcessGameFiles() {
     /*
-     * Removes excess game data files. Excess files when > 10 files. Oldest dated files removed first. Files with
-     * unreadable date names are destroyed first under assumption that they are of old unsupported format / processes.
+     * Starts retention of the GameData dir. The manifest of recorded games is trimmed on a background thread, oldest
+     * games first, whenever a game is added and the count, age or total size policy is exceeded.
      */
 
-    std::vector<std::pair<std::string, time_t>> pathTimes;
-
-    // Fetch all contents of GameData dir and convert paths to fileTimes in list
-    for (const auto& gameData : std::filesystem::directory_iterator(gameDataDirPath)) {
-        std::pair<std::string, time_t> pathTime;
-        std::string pathTimeString;
-        struct tm structtm {};
-
-        pathTime.first = gameData.path().string();
-
-        // now get timeString by removing the path to the folder + copy value
-        //remove folder path string leaving just date + copy
-        pathTimeString = pathTime.first.substr(gameDataDirPath.length()+1, std::string::npos);
-
-        // ensure folder name is long enough to house the full time string
-        if (pathTimeString.length() >= timeStringFormat.size() - 1) {
-            pathTimeString.erase(timeStringFormat.size() -1, std::string::npos);
+    if (gameDataManifest.IsOpen()) return;
 
-            // now currentTurn into structtm, >> is highlighted as an error yet works???
-            std::istringstream ss(pathTimeString);
-            ss >> std::get_time(&structtm, timeFormat.c_str());
-
-            // currentTurn into time_t which can be stored then compared
-            pathTime.second = mktime(&structtm);
-
-        } else {
-            // default to time 0
-            pathTime.second = 0;
-        }
-
-        pathTimes.push_back(pathTime);
-    }
-
-    // sort by time oldest -> newest
-    std::sort(pathTimes.begin(), pathTimes.end(),
-              [&](const std::pair<std::string, time_t>& pathTimeA,const std::pair<std::string, time_t>& pathTimeB){
-        return (pathTimeA.second < pathTimeB.second);
-    });
-
-    // remove folders
-    uintmax_t nRemoved = 0;
-    std::vector<std::string> dirsRemoved {};
-    for (auto pt = pathTimes.begin(); pt < pathTimes.end();) {
-        if (pathTimes.size() > 10) {
-            nRemoved += std::filesystem::remove_all(pt->first);
-            dirsRemoved.push_back(pt->first);
-
-            pt = pathTimes.erase(pt);
-            continue;
-        }
-        pt++;
-    }
-
-    // summary
-    printf("Removed directories:\n");
-    for (const auto& dir : dirsRemoved) {
-        printf("%s\n", dir.c_str());
-    }
-    printf("Removed %ju total files/Directories\n\n", nRemoved);
+    RetentionPolicy policy;
+    policy.maxGames = FetchConfigValue("GameDataKeepGames", 10);
+    policy.maxAgeDays = FetchConfigValue("GameDataKeepDays", 0);
+    policy.maxBytes = uint64_t(std::max(FetchConfigValue("GameDataKeepMB", 0), 0)) * 1024 * 1024;
+    gameDataManifest.Open(gameDataDirPath, policy);
 }
 
 bool Board::CreateGameFiles() {
@@ -512,7 +520,7 @@ bool Board::CreateGameFiles() {
      */
 
     // Path string for the game data folder in GameData dir
-    std::string gameDirPath = gameDataDirPath + "/";
+    gameDirPath = gameDataDirPath + "/";
 
     // Get date:
     char timeChar[timeStringFormat.size()];
@@ -536,19 +544,21 @@ bool Board::CreateGameFiles() {
         printf("failed to create GameData_Time_Copy dir, returning false.");
         return false;
     }
+    gameDataManifest.AddGame(gameDirPath);
 
-    // Create file to house ACN of game moves
+    // Create file to house ACN of game moves, kept open by the journal for the rest of the game
     moveListFilePath = gameDirPath + "/ACNmovelist.txt";
-    std::ofstream file(moveListFilePath);
-    if (!file.good()) {
-        file.close();
+    if (!moveJournal.Open(moveListFilePath, true)) {
         return false;
     }
-    file.close();
 
     // Create file to house ACN of piece start positions
     startPosFilePath = gameDirPath + "/ACNstartpos.csv";
-    file.open(startPosFilePath);
+    std::ofstream file(startPosFilePath);
+
+    // Binary record of the game, written at the end of the game
+    recordFilePath = gameDirPath + "/GameRecord.cgr";
+    pgnFilePath = gameDirPath + "/Game.pgn";
     if (!file.good()) {
         file.close();
         return false;
@@ -560,46 +570,86 @@ bool Board::CreateGameFiles() {
 
 bool Board::WriteStartPositionsToFile(const std::vector<std::unique_ptr<Piece>>& _whitePieces,
                                       const std::vector<std::unique_ptr<Piece>>& _blackPieces) {
-    std::fstream spFile(startPosFilePath.c_str());
+    // Build the file in memory and write it once
+    std::string spString;
+
+    for (const auto& pieces : {&_whitePieces, &_blackPieces}) {
+        for (const auto& piece : *pieces) {
+            auto pInfo = piece->GetPieceInfoPtr();
+            spString += pInfo->colID;
+            spString += "," + pInfo->name + "," + pInfo->gamepos.first + "," + std::to_string(pInfo->gamepos.second);
+            spString += '\n';
+        }
+    }
+
+    std::ofstream spFile(startPosFilePath, std::ios::binary);
     if (!spFile.good()) {
-        spFile.close();
         return false;
     }
+    spFile.write(spString.data(), (std::streamsize)spString.size());
 
-    // White Pieces
-    for (const auto& piece : _whitePieces) {
-        auto pInfo = piece->GetPieceInfoPtr();
-        std::string pInfoStr; pInfoStr.append(&pInfo->colID);
-        pInfoStr += "," + pInfo->name + "," + pInfo->gamepos.first + "," + std::to_string(pInfo->gamepos.second);
-        spFile << pInfoStr << std::endl;
-    }
+    return spFile.good();
+}
 
-    // Black Pieces
-    for (const auto& piece : _blackPieces) {
-        auto pInfo = piece->GetPieceInfoPtr();
-        std::string pInfoStr; pInfoStr.append(&pInfo->colID);
-        pInfoStr += "," + pInfo->name + "," + pInfo->gamepos.first + "," + std::to_string(pInfo->gamepos.second);
-        spFile << pInfoStr << std::endl;
-    }
+bool Board::WriteMoveToFile(const std::string& _move) {
+    if (!moveJournal.IsOpen()) return false;
+
+    if (halfturns % 2 == 0) moveJournal.Append("\n" + std::to_string(currentTurn) + ". ");
+    moveJournal.AppendMove(_move + " ");
 
-    spFile.close();
     return true;
 }
 
-bool Board::WriteMoveToFile(const std::string& _move) {
-    std::fstream mlFile(moveListFilePath.c_str(), std::ios::app);
-    if (!mlFile.good()) {
-        mlFile.close();
-        return false;
+bool Board::FlushGameFiles() {
+    bool recordSaved = gameRecord.IsEmpty() || recordFilePath.empty() || gameRecord.Save(recordFilePath);
+
+    // Finished games are also exported as PGN
+    if (recordSaved && !gameRecord.IsEmpty() && gameRecord.Result() != GameResult::ONGOING && !pgnFilePath.empty()) {
+        PgnWriter::WriteGame(PgnWriter::FromRecord(gameRecord), pgnFilePath, false);
+
+        // and added to the game database once, so they can be found by position
+        if (!recordInDatabase && (gameDatabase.IsOpen() || gameDatabase.Open(gameDatabaseDirPath))) {
+            recordInDatabase = gameDatabase.AddRecord(gameRecord);
+            gameDatabase.Commit();
+        }
     }
 
-    if (halfturns % 2 == 0) mlFile << std::endl << currentTurn << ". ";
-    mlFile << _move << " ";
+    bool journalFlushed = moveJournal.Flush();
+    if (!gameDirPath.empty()) gameDataManifest.UpdateGameSize(gameDirPath);
+
+    return journalFlushed && recordSaved;
+}
 
-    mlFile.close();
+void Board::CloseGameFiles() {
+    /*
+     * Saves the game in progress and lets go of its files, the next game gets its own from CreateGameFiles
+     */
+
+    FlushGameFiles();
+    moveJournal.Close();
+    gameDirPath.clear();
+    moveListFilePath.clear();
+    startPosFilePath.clear();
+    recordFilePath.clear();
+    pgnFilePath.clear();
+}
+
+bool Board::RecordStart(const std::string& _startFEN) {
+    recordInDatabase = false;
+    if (!gameRecord.Begin(_startFEN, (int64_t)time(nullptr))) return false;
+
+    gameRecord.AddMetadata("Site", "ChesSDL");
     return true;
 }
 
+bool Board::RecordMove(const std::string& _uciMove) {
+    return gameRecord.AddMove(_uciMove);
+}
+
+void Board::RecordResult(GameResult _result) {
+    gameRecord.SetResult(_result);
+}
+
 std::string Board::CreateFEN(const std::vector<std::unique_ptr<Piece>>& _teamPieces,
                              const std::vector<std::unique_ptr<Piece>>& _oppPieces) const {
     // Create FEN string for current position
@@ -650,65 +700,35 @@ std::string Board::CreateFEN(const std::vector<std::unique_ptr<Piece>>& _teamPie
     // remove last /
     FENstr.pop_back();
 
-    // Check whos currentTurn
-    FENstr += ((halfturns%2 == 0) ? " w " : " b ");
+    // Castling rights of both kings, written KQkq whichever side is the team
+    uint8_t castling = 0;
+    for (const auto* pieces : {&_teamPieces, &_oppPieces}) {
+        for (const auto& piece : *pieces) {
+            if (piece->GetPieceInfoPtr()->pieceID != 'K') continue;
 
-    // White castling status
-    bool castlePossible = false;
-
-    for (const auto& piece : _teamPieces) {
-        if (piece->GetPieceInfoPtr()->pieceID == 'K') {
             auto canCastle = piece->CanCastle();
-
-            if (canCastle.second) FENstr += 'K';
-            if (canCastle.first) FENstr += 'Q';
-
-            if (canCastle.first || canCastle.second) castlePossible = true;
+            bool white = piece->GetPieceInfoPtr()->colID == 'W';
+            if (canCastle.second) castling |= white ? Position::WHITE_KINGSIDE : Position::BLACK_KINGSIDE;
+            if (canCastle.first) castling |= white ? Position::WHITE_QUEENSIDE : Position::BLACK_QUEENSIDE;
             break;
         }
     }
 
-     // Black castling status
-    for (const auto& piece : _oppPieces) {
-        if (piece->GetPieceInfoPtr()->pieceID == 'K') {
-            auto canCastle = piece->CanCastle();
-
-            if (canCastle.second) FENstr += 'k';
-            if (canCastle.first) FENstr += 'q';
-
-            if (canCastle.first || canCastle.second) castlePossible = true;
-            break;
-        }
-    }
-
-    // no castling possible
-    if (!castlePossible) FENstr += '-';
-
-    // now denote possible en passant targets
-    for (const auto& piece : _teamPieces) {
-        std::pair<char, int> target {};
-        if (piece->CanPassant()) {
-            target = piece->GetPassantTarget();
-            FENstr += " ";
-            FENstr += target.first;
-            FENstr += std::to_string(target.second);
-            break;
-        }
-    }
+    // First en passant target found, team pieces before opp pieces
+    int epSquare = Position::NO_SQUARE;
+    for (const auto* pieces : {&_teamPieces, &_oppPieces}) {
+        for (const auto& piece : *pieces) {
+            if (!piece->CanPassant()) continue;
 
-    for (const auto& piece : _oppPieces) {
-        std::pair<char, int> target {};
-        if (piece->CanPassant()) {
-            target = piece->GetPassantTarget();
-            FENstr += " ";
-            FENstr += target.first;
-            FENstr += std::to_string(target.second);
+            auto target = piece->GetPassantTarget();
+            epSquare = Position::Square(target.first, target.second);
             break;
         }
+        if (epSquare != Position::NO_SQUARE) break;
     }
 
-    // num halfturns num turns
-    FENstr += " " + std::to_string(halfturns) + " " + std::to_string(currentTurn);
+    // Turn, castling, en passant, num halfturns num turns
+    FENstr += Position::FENState((halfturns%2 == 0) ? 'w' : 'b', castling, epSquare, halfturns, currentTurn);
 
     return FENstr;
 }
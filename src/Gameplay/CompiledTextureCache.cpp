@@ -0,0 +1,71 @@
+//
+// Created by cew05 on 19/10/2026.
+//
+
+#include "include/CompiledTextureCache.h"
+
+CompiledTextureCache::~CompiledTextureCache() {
+    Clear();
+}
+
+SDL_Texture* CompiledTextureCache::Fetch(const CompiledTextureKey& _key) {
+    auto it = lookup.find(_key);
+    if (it == lookup.end()) return nullptr;
+
+    // move to front as most recently used
+    entries.splice(entries.begin(), entries, it->second);
+    inUse[_key.kind] = _key;
+    return it->second->texture;
+}
+
+void CompiledTextureCache::Store(const CompiledTextureKey& _key, SDL_Texture* _texture) {
+    if (_texture == nullptr) return;
+
+    // replace any existing entry
+    auto it = lookup.find(_key);
+    if (it != lookup.end()) {
+        if (it->second->texture != _texture) SDL_DestroyTexture(it->second->texture);
+        usedBytes -= it->second->bytes;
+        entries.erase(it->second);
+        lookup.erase(it);
+    }
+
+    // RGBA8888 render targets
+    size_t bytes = size_t(_key.w) * size_t(_key.h) * 4;
+    entries.push_front({_key, _texture, bytes});
+    lookup[_key] = entries.begin();
+    usedBytes += bytes;
+    inUse[_key.kind] = _key;
+
+    Evict();
+}
+
+bool CompiledTextureCache::IsInUse(const CompiledTextureKey& _key) const {
+    const auto& used = inUse[_key.kind];
+    return used.has_value() && !(*used < _key) && !(_key < *used);
+}
+
+void CompiledTextureCache::Evict() {
+    // least recently used first, skipping the textures the Board is drawing
+    auto it = entries.end();
+    while (usedBytes > maxBytes && it != entries.begin()) {
+        it--;
+        if (IsInUse(it->key)) continue;
+
+        SDL_DestroyTexture(it->texture);
+        usedBytes -= it->bytes;
+        lookup.erase(it->key);
+        it = entries.erase(it);
+    }
+}
+
+void CompiledTextureCache::Clear() {
+    for (auto& entry : entries) {
+        SDL_DestroyTexture(entry.texture);
+    }
+
+    entries.clear();
+    lookup.clear();
+    usedBytes = 0;
+    for (auto& used : inUse) used.reset();
+}
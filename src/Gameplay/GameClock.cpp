@@ -0,0 +1,74 @@
+//
+// Created by cew05 on 19/10/2026.
+//
+
+#include "include/GameClock.h"
+
+GameClock::GameClock(Uint64 _baseMs, Uint64 _incMs) {
+    baseTime = _baseMs;
+    increment[0] = _incMs;
+    increment[1] = _incMs;
+
+    Reset();
+}
+
+void GameClock::Reset() {
+    remaining[0] = baseTime;
+    remaining[1] = baseTime;
+    activeSide = 0;
+    running = false;
+}
+
+void GameClock::Start(char _colID) {
+    activeSide = SideIndex(_colID);
+    turnStartTick = SDL_GetTicks64();
+    running = true;
+}
+
+void GameClock::Stop() {
+    if (!running) return;
+
+    // charge the time used so far to the side to move
+    remaining[activeSide] = GetRemaining(activeSide == 0 ? 'W' : 'B');
+    running = false;
+}
+
+void GameClock::Press() {
+    /*
+     * Ends the turn of the side to move: charges the time used, adds the increment then starts the opponents clock.
+     */
+
+    if (!running) return;
+
+    remaining[activeSide] = GetRemaining(activeSide == 0 ? 'W' : 'B');
+    if (remaining[activeSide] > 0) remaining[activeSide] += increment[activeSide];
+
+    activeSide = 1 - activeSide;
+    turnStartTick = SDL_GetTicks64();
+}
+
+Uint64 GameClock::GetRemaining(char _colID) const {
+    int side = SideIndex(_colID);
+    if (!running || side != activeSide) return remaining[side];
+
+    // deduct time used this turn, without going below 0
+    Uint64 used = SDL_GetTicks64() - turnStartTick;
+    return (used >= remaining[side]) ? 0 : remaining[side] - used;
+}
+
+Uint64 GameClock::GetIncrement(char _colID) const {
+    return increment[SideIndex(_colID)];
+}
+
+bool GameClock::HasFlagged(char _colID) const {
+    return baseTime > 0 && GetRemaining(_colID) == 0;
+}
+
+std::string GameClock::GetClockString(char _colID) const {
+    Uint64 seconds = GetRemaining(_colID) / 1000;
+
+    char clockChar[16];
+    snprintf(clockChar, sizeof(clockChar), "%02llu:%02llu", (unsigned long long)(seconds / 60),
+             (unsigned long long)(seconds % 60));
+    return clockChar;
+}
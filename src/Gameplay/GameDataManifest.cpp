@@ -0,0 +1,281 @@
+//
+// Created by cew05 on 19/10/2026.
+//
+
+#include "include/GameDataManifest.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <vector>
+
+GameDataManifest::~GameDataManifest() {
+    Close();
+}
+
+/*
+ * OPENING / CLOSING
+ */
+
+bool GameDataManifest::Open(const std::string& _gameDataDir, const RetentionPolicy& _policy) {
+    Close();
+
+    gameDataDir = _gameDataDir;
+    manifestPath = gameDataDir + "/Manifest.txt";
+    policy = _policy;
+    policy.maxGames = std::max(policy.maxGames, 1);
+
+    {
+        std::lock_guard<std::mutex> lock(manifestMutex);
+        if (!Load()) {
+            printf("No GameData manifest found, building one\n");
+            Rebuild();
+            Rewrite();
+        }
+        stopping = false;
+        trimRequested = true;
+    }
+
+    trimThread = std::thread(&GameDataManifest::TrimLoop, this);
+    return true;
+}
+
+void GameDataManifest::Close() {
+    if (!trimThread.joinable()) return;
+
+    {
+        std::lock_guard<std::mutex> lock(manifestMutex);
+        stopping = true;
+    }
+    trimWake.notify_one();
+    trimThread.join();
+
+    entries.clear();
+    totalBytes = 0;
+}
+
+/*
+ * MANIFEST FILE
+ */
+
+bool GameDataManifest::Load() {
+    entries.clear();
+    totalBytes = 0;
+
+    FILE* file = fopen(manifestPath.c_str(), "r");
+    if (file == nullptr) return false;
+
+    char line[512];
+    while (fgets(line, sizeof(line), file) != nullptr) {
+        int64_t created;
+        uint64_t bytes;
+        int nameStart = 0;
+        if (sscanf(line, "%" SCNd64 " %" SCNu64 " %n", &created, &bytes, &nameStart) != 2 || nameStart == 0) continue;
+
+        std::string name = line + nameStart;
+        while (!name.empty() && (name.back() == '\n' || name.back() == '\r')) name.pop_back();
+        if (name.empty()) continue;
+
+        // later lines replace earlier ones for the same game
+        if (Entry* entry = FindEntry(name)) {
+            totalBytes = totalBytes - entry->bytes + bytes;
+            entry->bytes = bytes;
+            continue;
+        }
+        entries.push_back({name, created, bytes});
+        totalBytes += bytes;
+    }
+    fclose(file);
+
+    // games are appended in creation order, but keep old manifests with out of order lines safe
+    std::stable_sort(entries.begin(), entries.end(), [](const Entry& _a, const Entry& _b) {
+        return _a.created < _b.created;
+    });
+    return true;
+}
+
+void GameDataManifest::Rebuild() {
+    /*
+     * One off scan for a GameData dir without a manifest, ordered by modification time
+     */
+
+    entries.clear();
+    totalBytes = 0;
+
+    std::error_code ec;
+    for (const auto& gameData : std::filesystem::directory_iterator(gameDataDir, ec)) {
+        if (!gameData.is_directory(ec)) continue;
+
+        uint64_t bytes = 0;
+        for (const auto& file : std::filesystem::recursive_directory_iterator(gameData.path(), ec)) {
+            if (file.is_regular_file(ec)) bytes += file.file_size(ec);
+        }
+
+        // file clock to time_t, only the order and rough age matter
+        auto written = std::filesystem::last_write_time(gameData.path(), ec);
+        auto sinceWrite = std::filesystem::file_time_type::clock::now() - written;
+        int64_t created = (int64_t)time(nullptr) - std::chrono::duration_cast<std::chrono::seconds>(sinceWrite).count();
+
+        entries.push_back({gameData.path().filename().string(), created, bytes});
+        totalBytes += bytes;
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const Entry& _a, const Entry& _b) {
+        return _a.created < _b.created;
+    });
+}
+
+bool GameDataManifest::Rewrite() {
+    std::string contents;
+    for (const Entry& entry : entries) {
+        contents += std::to_string(entry.created) + " " + std::to_string(entry.bytes) + " " + entry.name + "\n";
+    }
+
+    // replace the manifest whole, so it is never left half written
+    std::string tempPath = manifestPath + ".tmp";
+    FILE* file = fopen(tempPath.c_str(), "wb");
+    if (file == nullptr) {
+        printf("Failed to write GameData manifest %s\n", tempPath.c_str());
+        return false;
+    }
+    bool ok = fwrite(contents.data(), 1, contents.size(), file) == contents.size();
+    ok = (fclose(file) == 0) && ok;
+
+    std::error_code ec;
+    if (ok) std::filesystem::rename(tempPath, manifestPath, ec);
+    if (!ok || ec) {
+        printf("Failed to write GameData manifest %s\n", manifestPath.c_str());
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
+
+bool GameDataManifest::AppendLine(const Entry& _entry) {
+    FILE* file = fopen(manifestPath.c_str(), "ab");
+    if (file == nullptr) {
+        printf("Failed to update GameData manifest %s\n", manifestPath.c_str());
+        return false;
+    }
+
+    fprintf(file, "%" PRId64 " %" PRIu64 " %s\n", _entry.created, _entry.bytes, _entry.name.c_str());
+    return fclose(file) == 0;
+}
+
+GameDataManifest::Entry* GameDataManifest::FindEntry(const std::string& _name) {
+    // the game being updated is almost always the newest
+    for (auto entry = entries.rbegin(); entry != entries.rend(); entry++) {
+        if (entry->name == _name) return &*entry;
+    }
+    return nullptr;
+}
+
+/*
+ * GAMES
+ */
+
+bool GameDataManifest::AddGame(const std::string& _gameDirPath) {
+    Entry entry {std::filesystem::path(_gameDirPath).filename().string(), (int64_t)time(nullptr), 0};
+
+    {
+        std::lock_guard<std::mutex> lock(manifestMutex);
+        if (!trimThread.joinable() || FindEntry(entry.name) != nullptr) return false;
+
+        entries.push_back(entry);
+        if (!AppendLine(entry)) return false;
+        trimRequested = true;
+    }
+
+    trimWake.notify_one();
+    return true;
+}
+
+void GameDataManifest::UpdateGameSize(const std::string& _gameDirPath) {
+    std::error_code ec;
+    uint64_t bytes = 0;
+    for (const auto& file : std::filesystem::directory_iterator(_gameDirPath, ec)) {
+        if (file.is_regular_file(ec)) bytes += file.file_size(ec);
+    }
+
+    bool overBudget;
+    {
+        std::lock_guard<std::mutex> lock(manifestMutex);
+        Entry* entry = FindEntry(std::filesystem::path(_gameDirPath).filename().string());
+        if (entry == nullptr || entry->bytes == bytes) return;
+
+        totalBytes = totalBytes - entry->bytes + bytes;
+        entry->bytes = bytes;
+        AppendLine(*entry);
+
+        overBudget = policy.maxBytes != 0 && totalBytes > policy.maxBytes;
+        trimRequested |= overBudget;
+    }
+
+    if (overBudget) trimWake.notify_one();
+}
+
+void GameDataManifest::RequestTrim() {
+    {
+        std::lock_guard<std::mutex> lock(manifestMutex);
+        trimRequested = true;
+    }
+    trimWake.notify_one();
+}
+
+/*
+ * TRIMMING
+ */
+
+bool GameDataManifest::ExceedsPolicy(int64_t _now) const {
+    if ((int)entries.size() > policy.maxGames) return true;
+    if (policy.maxBytes != 0 && totalBytes > policy.maxBytes) return true;
+    if (policy.maxAgeDays > 0 && _now - entries.front().created > int64_t(policy.maxAgeDays) * 24 * 60 * 60) return true;
+    return false;
+}
+
+void GameDataManifest::TrimLoop() {
+    std::unique_lock<std::mutex> lock(manifestMutex);
+
+    while (true) {
+        trimWake.wait(lock, [this]() { return trimRequested || stopping; });
+        if (stopping) return;
+
+        trimRequested = false;
+        lock.unlock();
+        Trim();
+        lock.lock();
+    }
+}
+
+void GameDataManifest::Trim() {
+    /*
+     * Retires the oldest games while over the policy. The newest game is never removed, it is the one being played
+     */
+
+    std::vector<std::string> expired;
+    {
+        std::lock_guard<std::mutex> lock(manifestMutex);
+        int64_t now = time(nullptr);
+        while (entries.size() > 1 && ExceedsPolicy(now)) {
+            expired.push_back(entries.front().name);
+            totalBytes -= entries.front().bytes;
+            entries.pop_front();
+        }
+    }
+    if (expired.empty()) return;
+
+    // remove directories without holding the lock, games can still be added meanwhile
+    uintmax_t nRemoved = 0;
+    std::error_code ec;
+    for (const std::string& name : expired) {
+        uintmax_t removed = std::filesystem::remove_all(gameDataDir + "/" + name, ec);
+        if (ec) printf("Failed to remove %s/%s\n", gameDataDir.c_str(), name.c_str());
+        else nRemoved += removed;
+    }
+    printf("Removed %zu old games, %ju total files/Directories\n", expired.size(), nRemoved);
+
+    std::lock_guard<std::mutex> lock(manifestMutex);
+    Rewrite();
+}
@@ -0,0 +1,557 @@
+//
+// Created by cew05 on 19/10/2026.
+//
+
+#include "include/GameDatabase.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+
+// Size of a stored game, padded so every game header is aligned
+static uint64_t GameEntryLength(uint64_t _fenLength, uint64_t _metaLength, uint64_t _plyCount) {
+    return (sizeof(GameEntryHeader) + _fenLength + _metaLength + _plyCount * sizeof(Move16) + 7) & ~7ull;
+}
+
+GameDatabase::~GameDatabase() {
+    Close();
+}
+
+/*
+ * OPENING / CLOSING
+ */
+
+bool GameDatabase::Open(const std::string& _directory, bool _readOnly) {
+    Close();
+
+    std::error_code ec;
+    if (!_readOnly) std::filesystem::create_directories(_directory, ec);
+    if (!std::filesystem::is_directory(_directory, ec)) {
+        printf("Failed to %s game database dir %s\n", _readOnly ? "find" : "create", _directory.c_str());
+        return false;
+    }
+
+    directory = _directory;
+    gamesPath = directory + "/Games.cgd";
+    readOnly = _readOnly;
+
+    std::lock_guard<std::mutex> lock(pendingMutex);
+    if (!LoadGames() || !LoadRuns()) {
+        gamesFile.Close();
+        runs.clear();
+        gameOffsets.clear();
+        return false;
+    }
+
+    open = true;
+    return true;
+}
+
+void GameDatabase::Close() {
+    if (open && !readOnly) Commit();
+
+    std::lock_guard<std::mutex> lock(pendingMutex);
+    open = false;
+    runs.clear();
+    gamesFile.Close();
+    gameOffsets.clear();
+    gamesEnd = 0;
+    pendingGames.clear();
+    pendingEntries.clear();
+    pendingCount = 0;
+}
+
+bool GameDatabase::LoadGames() {
+    /*
+     * Finds the offset of every stored game. A partly written game at the end of the file is cut off
+     */
+
+    gameOffsets.clear();
+    gamesEnd = 0;
+
+    std::error_code ec;
+    uint64_t fileSize = std::filesystem::exists(gamesPath, ec) ? std::filesystem::file_size(gamesPath, ec) : 0;
+    if (fileSize == 0) return true;
+    if (!gamesFile.OpenRead(gamesPath)) return false;
+
+    const unsigned char* data = gamesFile.Data();
+    uint64_t size = gamesFile.Size();
+    GameEntryHeader header {};
+
+    while (gamesEnd + sizeof(GameEntryHeader) <= size) {
+        memcpy(&header, data + gamesEnd, sizeof(header));
+        if (header.magic != gameMagic) break;
+        if (header.length != GameEntryLength(header.fenLength, header.metaLength, header.plyCount)) break;
+        if (gamesEnd + header.length > size) break;
+
+        gameOffsets.push_back(gamesEnd);
+        gamesEnd += header.length;
+    }
+
+    // read only, the end may be a game another instance is still appending
+    if (gamesEnd < size && !readOnly) {
+        printf("Game database %s ends with a damaged game, keeping the first %zu games\n", gamesPath.c_str(),
+               gameOffsets.size());
+        gamesFile.Close();
+        std::filesystem::resize_file(gamesPath, gamesEnd, ec);
+        if (ec) {
+            printf("Failed to cut off damaged game in %s\n", gamesPath.c_str());
+            return false;
+        }
+        if (gamesEnd > 0 && !gamesFile.OpenRead(gamesPath)) return false;
+    }
+
+    return true;
+}
+
+bool GameDatabase::LoadRuns() {
+    /*
+     * Keeps the runs that cover game ids from 0 without gaps. Runs left behind by an interrupted merge lie inside the
+     * merged run and are removed; games not covered by any run are indexed again
+     */
+
+    runs.clear();
+
+    std::vector<std::pair<uint32_t, uint32_t>> ranges;
+    for (const auto& dirEntry : std::filesystem::directory_iterator(directory)) {
+        std::string name = dirEntry.path().filename().string();
+        unsigned int first, end;
+        char extension[8] {};
+        if (sscanf(name.c_str(), "Positions-%u-%u.%7s", &first, &end, extension) != 3) continue;
+        if (strcmp(extension, "cpi") != 0) {
+            // unfinished run
+            if (strcmp(extension, "cpi.tmp") == 0 && !readOnly) RemoveFile(dirEntry.path().string());
+            continue;
+        }
+        ranges.emplace_back(first, end);
+    }
+
+    // widest run first when two start at the same game
+    std::sort(ranges.begin(), ranges.end(), [](const auto& _a, const auto& _b) {
+        return _a.first != _b.first ? _a.first < _b.first : _a.second > _b.second;
+    });
+
+    uint32_t covered = 0;
+    for (const auto& [first, end] : ranges) {
+        PositionRun run {std::make_unique<MappedFile>(), RunPath(first, end), first, end, nullptr, 0};
+        if (first == covered && end > first && end <= GameCount() && MapRun(run)) {
+            runs.push_back(std::move(run));
+            covered = end;
+            continue;
+        }
+
+        run.file->Close();
+        if (!readOnly) RemoveFile(run.path);
+    }
+
+    // read only, uncovered games can still be fetched, they are indexed when the database is next opened to write
+    if (covered < GameCount() && !readOnly) {
+        printf("Indexing %u games missing from the game database index\n", GameCount() - covered);
+        return IndexStoredGames(covered);
+    }
+
+    return true;
+}
+
+bool GameDatabase::MapRun(PositionRun& _run) {
+    if (!_run.file->OpenRead(_run.path)) return false;
+
+    const auto* header = (const PositionRunHeader*)_run.file->Data();
+    uint64_t size = _run.file->Size();
+    bool valid = size >= sizeof(PositionRunHeader) &&
+                 memcmp(header->magic, "CGPI", 4) == 0 &&
+                 header->version == runVersion &&
+                 header->firstGame == _run.firstGame && header->endGame == _run.endGame &&
+                 sizeof(PositionRunHeader) + header->entryCount * sizeof(PositionEntry) == size;
+
+    if (!valid) {
+        printf("Game database index %s is not valid\n", _run.path.c_str());
+        _run.file->Close();
+        return false;
+    }
+
+    _run.entries = (const PositionEntry*)(_run.file->Data() + sizeof(PositionRunHeader));
+    _run.entryCount = header->entryCount;
+    return true;
+}
+
+std::string GameDatabase::RunPath(uint32_t _firstGame, uint32_t _endGame) const {
+    return directory + "/Positions-" + std::to_string(_firstGame) + "-" + std::to_string(_endGame) + ".cpi";
+}
+
+void GameDatabase::RemoveFile(const std::string& _path) {
+    // another process may still have the file mapped, it is then removed the next time the database is opened
+    std::error_code ec;
+    std::filesystem::remove(_path, ec);
+}
+
+/*
+ * INDEX RUNS
+ */
+
+void GameDatabase::IndexGame(const Position& _start, const std::vector<Move16>& _moves, GameResult _result,
+                             uint32_t _gameID, std::vector<PositionEntry>& _entries) {
+    Position position = _start;
+    int plies = std::min((int)_moves.size(), maxIndexedPly);
+
+    for (int ply = 0; ply <= plies; ply++) {
+        Move16 next = (ply < (int)_moves.size()) ? _moves[ply] : Position::MOVE_NONE;
+        _entries.push_back({position.Key(), _gameID, next, uint16_t((ply << 2) | (int)_result)});
+        if (ply < plies) position.Apply(_moves[ply]);
+    }
+}
+
+bool GameDatabase::WriteRun(const std::string& _path, uint32_t _firstGame, uint32_t _endGame, const PositionEntry* _a,
+                            uint64_t _aCount, const PositionEntry* _b, uint64_t _bCount) {
+    /*
+     * Writes the merge of two sorted entry lists to a temporary file that is renamed into place once complete
+     */
+
+    std::string tempPath = _path + ".tmp";
+    FILE* file = fopen(tempPath.c_str(), "wb");
+    if (file == nullptr) {
+        printf("Failed to write game database index %s\n", tempPath.c_str());
+        return false;
+    }
+
+    PositionRunHeader header {};
+    memcpy(header.magic, "CGPI", 4);
+    header.version = runVersion;
+    header.firstGame = _firstGame;
+    header.endGame = _endGame;
+    header.entryCount = _aCount + _bCount;
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+
+    // merge in blocks to keep writes large
+    std::vector<PositionEntry> block;
+    block.reserve(1 << 16);
+    const PositionEntry* aEnd = _a + _aCount;
+    const PositionEntry* bEnd = _b + _bCount;
+
+    while (ok && (_a != aEnd || _b != bEnd)) {
+        block.clear();
+        while (block.size() < block.capacity() && (_a != aEnd || _b != bEnd)) {
+            if (_b == bEnd || (_a != aEnd && !(*_b < *_a))) block.push_back(*_a++);
+            else block.push_back(*_b++);
+        }
+        ok = fwrite(block.data(), sizeof(PositionEntry), block.size(), file) == block.size();
+    }
+    ok = (fclose(file) == 0) && ok;
+
+    std::error_code ec;
+    if (ok) std::filesystem::rename(tempPath, _path, ec);
+    if (!ok || ec) {
+        printf("Failed to write game database index %s\n", _path.c_str());
+        RemoveFile(tempPath);
+        return false;
+    }
+
+    return true;
+}
+
+bool GameDatabase::AddRun(uint32_t _firstGame, uint32_t _endGame, std::vector<PositionEntry>& _entries) {
+    std::sort(_entries.begin(), _entries.end());
+
+    PositionRun run {std::make_unique<MappedFile>(), RunPath(_firstGame, _endGame), _firstGame, _endGame, nullptr, 0};
+    if (!WriteRun(run.path, _firstGame, _endGame, _entries.data(), _entries.size(), nullptr, 0)) return false;
+    if (!MapRun(run)) return false;
+
+    runs.push_back(std::move(run));
+    return MergeRuns();
+}
+
+bool GameDatabase::MergeRuns() {
+    /*
+     * Merges the newest run into the one before it while it is at least half that run's size, so each run is at most
+     * half the size of the one before it
+     */
+
+    while (runs.size() >= 2 && runs.back().entryCount * 2 >= runs[runs.size() - 2].entryCount) {
+        PositionRun& older = runs[runs.size() - 2];
+        PositionRun& newer = runs.back();
+
+        PositionRun merged {std::make_unique<MappedFile>(), RunPath(older.firstGame, newer.endGame), older.firstGame,
+                            newer.endGame, nullptr, 0};
+        if (!WriteRun(merged.path, merged.firstGame, merged.endGame, older.entries, older.entryCount,
+                      newer.entries, newer.entryCount)) return false;
+
+        // the merged run covers both, so they can go even if mapping it fails, it is then mapped on the next open
+        std::string olderPath = older.path, newerPath = newer.path;
+        runs.pop_back();
+        runs.pop_back();
+        RemoveFile(olderPath);
+        RemoveFile(newerPath);
+
+        if (!MapRun(merged)) return false;
+        runs.push_back(std::move(merged));
+    }
+
+    return true;
+}
+
+bool GameDatabase::IndexStoredGames(uint32_t _firstGame) {
+    std::vector<PositionEntry> entries;
+    StoredGame game;
+    Position start;
+    uint32_t runStart = _firstGame;
+
+    for (uint32_t gameID = _firstGame; gameID < GameCount(); gameID++) {
+        if (!FetchGame(gameID, game) || !start.FromFEN(game.startFEN)) {
+            printf("Stored game %u could not be read, it will not be found by position\n", gameID);
+        } else {
+            IndexGame(start, game.moves, game.result, gameID, entries);
+        }
+
+        if (entries.size() >= maxPendingEntries || gameID + 1 == GameCount()) {
+            if (!AddRun(runStart, gameID + 1, entries)) return false;
+            entries.clear();
+            runStart = gameID + 1;
+        }
+    }
+
+    return true;
+}
+
+/*
+ * ADDING GAMES
+ */
+
+bool GameDatabase::AddGame(const std::string& _startFEN, const std::vector<Move16>& _moves, GameResult _result,
+                           const std::string& _metadata, int64_t _startTime) {
+    if (!open || readOnly) return false;
+
+    Position start;
+    if (_startFEN.size() > UINT16_MAX || !start.FromFEN(_startFEN)) {
+        printf("Game database could not read start FEN %s\n", _startFEN.c_str());
+        return false;
+    }
+
+    // Build the stored game and its positions before taking the lock
+    GameEntryHeader header {};
+    header.magic = gameMagic;
+    header.plyCount = (uint32_t)_moves.size();
+    header.metaLength = (uint32_t)_metadata.size();
+    header.fenLength = (uint16_t)_startFEN.size();
+    header.result = (uint8_t)_result;
+    header.startTime = _startTime;
+    header.length = (uint32_t)GameEntryLength(header.fenLength, header.metaLength, header.plyCount);
+
+    std::string entry((const char*)&header, sizeof(header));
+    entry += _startFEN;
+    entry += _metadata;
+    entry.append((const char*)_moves.data(), _moves.size() * sizeof(Move16));
+    entry.resize(header.length, '\0');
+
+    std::vector<PositionEntry> positions;
+    positions.reserve(_moves.size() + 1);
+    IndexGame(start, _moves, _result, 0, positions);
+
+    std::lock_guard<std::mutex> lock(pendingMutex);
+    uint32_t gameID = GameCount() + pendingCount++;
+    for (PositionEntry& position : positions) position.gameID = gameID;
+
+    pendingGames += entry;
+    pendingEntries.insert(pendingEntries.end(), positions.begin(), positions.end());
+
+    if (pendingEntries.size() >= maxPendingEntries) return CommitLocked();
+    return true;
+}
+
+bool GameDatabase::AddRecord(const GameRecord& _record) {
+    if (_record.IsEmpty()) return false;
+    return AddGame(_record.StartFEN(), _record.Moves(), _record.Result(), _record.Metadata(), _record.StartTime());
+}
+
+bool GameDatabase::AddRecord(const GameRecordReader& _record) {
+    if (!_record.IsOpen()) return false;
+
+    std::vector<Move16> moves(_record.PlyCount());
+    for (int ply = 0; ply < _record.PlyCount(); ply++) moves[ply] = _record.MoveAt(ply);
+    return AddGame(_record.StartFEN(), moves, _record.Result(), _record.Metadata(), _record.StartTime());
+}
+
+bool GameDatabase::AddPgnGame(const PgnGame& _game) {
+    // tags are kept as metadata lines like a game record's
+    std::string metadata;
+    for (const auto& [name, value] : _game.tags) {
+        std::string line = name + "=" + value;
+        std::replace(line.begin(), line.end(), '\n', ' ');
+        metadata += line + "\n";
+    }
+
+    return AddGame(_game.startFEN, _game.moves, _game.result, metadata);
+}
+
+size_t GameDatabase::ImportPgn(const std::string& _path, int _threads) {
+    PgnReader reader;
+    if (!open || readOnly || !reader.Open(_path)) return 0;
+
+    std::atomic<size_t> added {0};
+    reader.ReadAll([this, &added](const PgnGame& _game) {
+        if (AddPgnGame(_game)) added++;
+    }, _threads);
+
+    Commit();
+    printf("Imported %zu games from %s, %zu rejected\n", added.load(), _path.c_str(), reader.GamesRejected());
+    return added;
+}
+
+bool GameDatabase::Commit() {
+    std::lock_guard<std::mutex> lock(pendingMutex);
+    return CommitLocked();
+}
+
+bool GameDatabase::CommitLocked() {
+    /*
+     * Appends the pending games to the games file, then writes their positions as a new run
+     */
+
+    if (!open || pendingCount == 0) return true;
+
+    FILE* file = fopen(gamesPath.c_str(), "ab");
+    if (file == nullptr) {
+        printf("Failed to open game database %s\n", gamesPath.c_str());
+        return false;
+    }
+    bool ok = fwrite(pendingGames.data(), 1, pendingGames.size(), file) == pendingGames.size();
+    ok = (fclose(file) == 0) && ok;
+    if (!ok) {
+        printf("Failed to write games to %s\n", gamesPath.c_str());
+        return false;
+    }
+
+    // Offsets of the new games, then remap to include them
+    uint32_t firstGame = GameCount();
+    GameEntryHeader header {};
+    for (uint64_t offset = 0; offset < pendingGames.size(); offset += header.length) {
+        memcpy(&header, pendingGames.data() + offset, sizeof(header));
+        gameOffsets.push_back(gamesEnd + offset);
+    }
+    gamesEnd += pendingGames.size();
+
+    pendingGames.clear();
+    pendingCount = 0;
+    if (!gamesFile.OpenRead(gamesPath)) return false;
+
+    std::vector<PositionEntry> entries;
+    entries.swap(pendingEntries);
+    return AddRun(firstGame, GameCount(), entries);
+}
+
+/*
+ * QUERIES
+ */
+
+void GameDatabase::RunRange(const PositionRun& _run, uint64_t _key, const PositionEntry*& _begin,
+                            const PositionEntry*& _end) {
+    const PositionEntry* entriesEnd = _run.entries + _run.entryCount;
+    _begin = std::lower_bound(_run.entries, entriesEnd, _key, [](const PositionEntry& _entry, uint64_t _value) {
+        return _entry.key < _value;
+    });
+    _end = std::upper_bound(_begin, entriesEnd, _key, [](uint64_t _value, const PositionEntry& _entry) {
+        return _value < _entry.key;
+    });
+}
+
+void GameDatabase::FindGames(const Position& _position, std::vector<PositionHit>& _hits, size_t _limit) const {
+    /*
+     * Lists each game through the position once, at the first ply it was reached, in game id order
+     */
+
+    _hits.clear();
+    uint64_t key = _position.Key();
+
+    // runs cover increasing game ids and entries are sorted by game then ply, so each game's first entry comes first
+    for (const PositionRun& run : runs) {
+        const PositionEntry *begin, *end;
+        RunRange(run, key, begin, end);
+
+        for (const PositionEntry* entry = begin; entry != end && _hits.size() < _limit; entry++) {
+            if (!_hits.empty() && _hits.back().gameID == entry->gameID) continue;
+            _hits.push_back({entry->gameID, entry->Ply()});
+        }
+    }
+}
+
+uint64_t GameDatabase::CountGames(const Position& _position) const {
+    uint64_t key = _position.Key();
+    uint64_t count = 0;
+
+    for (const PositionRun& run : runs) {
+        const PositionEntry *begin, *end;
+        RunRange(run, key, begin, end);
+
+        for (const PositionEntry* entry = begin; entry != end; entry++) {
+            if (entry == begin || entry[-1].gameID != entry->gameID) count++;
+        }
+    }
+
+    return count;
+}
+
+void GameDatabase::FetchMoveStatistics(const Position& _position, std::vector<MoveStatistic>& _statistics) const {
+    /*
+     * Totals the move played the first time each game reached the position, most played first
+     */
+
+    _statistics.clear();
+    uint64_t key = _position.Key();
+    bool whiteToMove = _position.SideToMove() == 'w';
+
+    for (const PositionRun& run : runs) {
+        const PositionEntry *begin, *end;
+        RunRange(run, key, begin, end);
+
+        for (const PositionEntry* entry = begin; entry != end; entry++) {
+            if (entry != begin && entry[-1].gameID == entry->gameID) continue;
+            if (entry->nextMove == Position::MOVE_NONE) continue;
+
+            auto statistic = std::find_if(_statistics.begin(), _statistics.end(), [entry](const MoveStatistic& _s) {
+                return _s.move == entry->nextMove;
+            });
+            if (statistic == _statistics.end()) {
+                _statistics.emplace_back();
+                statistic = _statistics.end() - 1;
+                statistic->move = entry->nextMove;
+            }
+
+            statistic->games++;
+            switch (entry->Result()) {
+                case GameResult::WHITE_WIN:
+                    (whiteToMove ? statistic->wins : statistic->losses)++;
+                    break;
+                case GameResult::BLACK_WIN:
+                    (whiteToMove ? statistic->losses : statistic->wins)++;
+                    break;
+                case GameResult::DRAW:
+                    statistic->draws++;
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+    std::sort(_statistics.begin(), _statistics.end(), [](const MoveStatistic& _a, const MoveStatistic& _b) {
+        return _a.games > _b.games;
+    });
+}
+
+bool GameDatabase::FetchGame(uint32_t _gameID, StoredGame& _game) const {
+    if (_gameID >= GameCount() || !gamesFile.IsOpen()) return false;
+
+    const unsigned char* entry = gamesFile.Data() + gameOffsets[_gameID];
+    GameEntryHeader header {};
+    memcpy(&header, entry, sizeof(header));
+    entry += sizeof(header);
+
+    _game.startFEN.assign((const char*)entry, header.fenLength);
+    entry += header.fenLength;
+    _game.metadata.assign((const char*)entry, header.metaLength);
+    entry += header.metaLength;
+    _game.moves.resize(header.plyCount);
+    memcpy(_game.moves.data(), entry, header.plyCount * sizeof(Move16));
+    _game.result = GameResult(header.result);
+    _game.startTime = header.startTime;
+    return true;
+}
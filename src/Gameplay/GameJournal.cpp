@@ -0,0 +1,93 @@
+//
+// Created by cew05 on 19/10/2026.
+//
+
+#include "include/GameJournal.h"
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+GameJournal::~GameJournal() {
+    Close();
+}
+
+void GameJournal::SetFlushPolicy(int _moves, int _intervalMs, bool _sync) {
+    flushMoves = std::max(_moves, 1);
+    flushInterval = Uint64(std::max(_intervalMs, 0));
+    syncOnFlush = _sync;
+}
+
+bool GameJournal::Open(const std::string& _path, bool _truncate) {
+    // finish any previous file first
+    Close();
+
+    file = fopen(_path.c_str(), _truncate ? "wb" : "ab");
+    if (file == nullptr) {
+        printf("Failed to open game journal %s\n", _path.c_str());
+        return false;
+    }
+
+    // the journal does its own buffering
+    setvbuf(file, nullptr, _IONBF, 0);
+
+    path = _path;
+    pendingMoves = 0;
+    lastFlushTick = SDL_GetTicks64();
+    return true;
+}
+
+void GameJournal::Close() {
+    if (file == nullptr) return;
+
+    Flush();
+    fclose(file);
+    file = nullptr;
+}
+
+void GameJournal::Append(const std::string& _text) {
+    buffer += _text;
+}
+
+void GameJournal::AppendMove(const std::string& _text) {
+    buffer += _text;
+    pendingMoves++;
+
+    if (pendingMoves >= flushMoves) Flush();
+    else Tick();
+}
+
+void GameJournal::Tick() {
+    // Buffered text is flushed once the interval has passed, even if no more moves are made
+    if (file == nullptr || buffer.empty() || flushInterval == 0) return;
+    if (SDL_GetTicks64() - lastFlushTick >= flushInterval) Flush();
+}
+
+bool GameJournal::Flush() {
+    if (file == nullptr) return false;
+
+    pendingMoves = 0;
+    lastFlushTick = SDL_GetTicks64();
+    if (buffer.empty()) return true;
+
+    size_t written = fwrite(buffer.data(), 1, buffer.size(), file);
+    if (written != buffer.size()) {
+        printf("Failed to write game journal %s\n", path.c_str());
+        buffer.erase(0, written);
+        return false;
+    }
+    buffer.clear();
+
+    if (syncOnFlush) {
+        fflush(file);
+#ifdef _WIN32
+        _commit(_fileno(file));
+#else
+        fsync(fileno(file));
+#endif
+    }
+
+    return true;
+}
@@ -0,0 +1,197 @@
+//
+// Created by cew05 on 19/10/2026.
+//
+
+#include "include/GameRecord.h"
+
+#include <cstring>
+#include <filesystem>
+
+/*
+ * WRITING
+ */
+
+void GameRecord::SetKeyframeInterval(int _plies) {
+    keyframeInterval = uint16_t(std::min(std::max(_plies, 1), 1024));
+}
+
+bool GameRecord::Begin(const std::string& _startFEN, int64_t _startTime) {
+    startFEN.clear();
+    metadata.clear();
+    moves.clear();
+    keyframes.clear();
+    result = GameResult::ONGOING;
+    startTime = _startTime;
+
+    if (!position.FromFEN(_startFEN)) {
+        printf("Game record could not read start FEN %s\n", _startFEN.c_str());
+        return false;
+    }
+    startFEN = _startFEN;
+
+    // keyframe 0 is the start position
+    keyframes.emplace_back();
+    position.Pack(keyframes.back());
+    return true;
+}
+
+void GameRecord::AddMetadata(const std::string& _key, const std::string& _value) {
+    metadata += _key + "=" + _value + "\n";
+}
+
+bool GameRecord::AddMove(const std::string& _uci) {
+    if (IsEmpty()) return false;
+
+    Move16 move = position.ParseUCI(_uci);
+    if (move == Position::MOVE_NONE) {
+        printf("Game record could not read move %s\n", _uci.c_str());
+        return false;
+    }
+
+    position.Apply(move);
+    moves.push_back(move);
+
+    if (moves.size() % keyframeInterval == 0) {
+        keyframes.emplace_back();
+        position.Pack(keyframes.back());
+    }
+    return true;
+}
+
+bool GameRecord::Save(const std::string& _path) const {
+    /*
+     * Writes to a temporary file which then replaces the record, so a crash mid write leaves the previous record intact
+     */
+
+    if (IsEmpty()) return false;
+
+    GameRecordHeader header {};
+    memcpy(header.magic, "CGRC", 4);
+    header.version = version;
+    header.keyframeInterval = keyframeInterval;
+    header.plyCount = (uint32_t)moves.size();
+    header.keyframeCount = (uint32_t)keyframes.size();
+    header.fenOffset = sizeof(GameRecordHeader);
+    header.fenLength = (uint32_t)startFEN.size();
+    header.metaOffset = header.fenOffset + header.fenLength;
+    header.metaLength = (uint32_t)metadata.size();
+    header.movesOffset = header.metaOffset + header.metaLength;
+
+    // keyframes are aligned for direct access through the mapped view
+    header.keyframesOffset = (header.movesOffset + header.plyCount * sizeof(Move16) + 7) & ~7u;
+    header.startTime = startTime;
+    header.result = (uint8_t)result;
+
+    std::string tempPath = _path + ".tmp";
+    FILE* file = fopen(tempPath.c_str(), "wb");
+    if (file == nullptr) {
+        printf("Failed to write game record %s\n", tempPath.c_str());
+        return false;
+    }
+
+    const char padding[8] {};
+    size_t movesEnd = header.movesOffset + header.plyCount * sizeof(Move16);
+
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+    ok = ok && fwrite(startFEN.data(), 1, startFEN.size(), file) == startFEN.size();
+    ok = ok && fwrite(metadata.data(), 1, metadata.size(), file) == metadata.size();
+    ok = ok && fwrite(moves.data(), sizeof(Move16), moves.size(), file) == moves.size();
+    ok = ok && fwrite(padding, 1, header.keyframesOffset - movesEnd, file) == header.keyframesOffset - movesEnd;
+    ok = ok && fwrite(keyframes.data(), sizeof(PackedPosition), keyframes.size(), file) == keyframes.size();
+    ok = (fclose(file) == 0) && ok;
+
+    if (!ok) {
+        printf("Failed to write game record %s\n", tempPath.c_str());
+        std::filesystem::remove(tempPath);
+        return false;
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tempPath, _path, ec);
+    if (ec) {
+        printf("Failed to replace game record %s\n", _path.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+/*
+ * READING
+ */
+
+bool GameRecordReader::Open(const std::string& _path) {
+    Close();
+
+    if (!recordFile.OpenRead(_path)) {
+        printf("Failed to open game record %s\n", _path.c_str());
+        return false;
+    }
+
+    // Check the header and that every section lies inside the file
+    const auto* fileHeader = (const GameRecordHeader*)recordFile.Data();
+    uint64_t size = recordFile.Size();
+    bool valid = size >= sizeof(GameRecordHeader) &&
+                 memcmp(fileHeader->magic, "CGRC", 4) == 0 &&
+                 fileHeader->version == 1 &&
+                 fileHeader->keyframeInterval > 0 &&
+                 (uint64_t)fileHeader->fenOffset + fileHeader->fenLength <= size &&
+                 (uint64_t)fileHeader->metaOffset + fileHeader->metaLength <= size &&
+                 (uint64_t)fileHeader->movesOffset + (uint64_t)fileHeader->plyCount * sizeof(Move16) <= size &&
+                 fileHeader->keyframeCount == fileHeader->plyCount / fileHeader->keyframeInterval + 1 &&
+                 (uint64_t)fileHeader->keyframesOffset + (uint64_t)fileHeader->keyframeCount * sizeof(PackedPosition) <= size;
+
+    if (!valid) {
+        printf("Game record %s is not a valid record\n", _path.c_str());
+        recordFile.Close();
+        return false;
+    }
+
+    header = fileHeader;
+    return true;
+}
+
+void GameRecordReader::Close() {
+    header = nullptr;
+    recordFile.Close();
+}
+
+std::string GameRecordReader::StartFEN() const {
+    if (!header) return {};
+    return {(const char*)recordFile.Data() + header->fenOffset, header->fenLength};
+}
+
+std::string GameRecordReader::Metadata() const {
+    if (!header) return {};
+    return {(const char*)recordFile.Data() + header->metaOffset, header->metaLength};
+}
+
+Move16 GameRecordReader::MoveAt(int _ply) const {
+    // _ply is the index of the move, so MoveAt(0) is the first move of the game
+    if (!header || _ply < 0 || _ply >= (int)header->plyCount) return Position::MOVE_NONE;
+
+    Move16 move;
+    memcpy(&move, recordFile.Data() + header->movesOffset + _ply * sizeof(Move16), sizeof(Move16));
+    return move;
+}
+
+bool GameRecordReader::FetchKeyframe(int _index, Position& _position) const {
+    if (!header || _index < 0 || _index >= (int)header->keyframeCount) return false;
+
+    PackedPosition packed;
+    memcpy(&packed, recordFile.Data() + header->keyframesOffset + _index * sizeof(PackedPosition), sizeof(packed));
+    _position.Unpack(packed);
+    return true;
+}
+
+bool GameRecordReader::SeekPly(int _ply, Position& _position) const {
+    if (!header || _ply < 0 || _ply > (int)header->plyCount) return false;
+
+    int keyframe = _ply / header->keyframeInterval;
+    if (!FetchKeyframe(keyframe, _position)) return false;
+
+    for (int ply = keyframe * header->keyframeInterval; ply < _ply; ply++) {
+        _position.Apply(MoveAt(ply));
+    }
+    return true;
+}
@@ -0,0 +1,110 @@
+//
+// Created by cew05 on 19/10/2026.
+//
+
+#include "include/GameReview.h"
+
+/*
+ * LOADING
+ */
+
+bool GameReview::Load(const std::string& _startFEN, const std::vector<Move16>& _moves, GameResult _result) {
+    /*
+     * Replays the game once to build its keyframes, then rests on the start position
+     */
+
+    Clear();
+    if (!position.FromFEN(_startFEN)) {
+        printf("Game review could not read start FEN %s\n", _startFEN.c_str());
+        return false;
+    }
+
+    keyframes.reserve(_moves.size() / keyframeInterval + 1);
+    for (size_t move = 0; move <= _moves.size(); move++) {
+        if (move % keyframeInterval == 0) {
+            keyframes.emplace_back();
+            position.Pack(keyframes.back());
+        }
+        if (move < _moves.size()) position.Apply(_moves[move]);
+    }
+
+    startFEN = _startFEN;
+    moves = _moves;
+    result = _result;
+    undoStates.reserve(keyframeInterval);
+
+    LoadKeyframe(0);
+    return true;
+}
+
+bool GameReview::Load(const GameRecordReader& _record) {
+    if (!_record.IsOpen()) return false;
+
+    std::vector<Move16> recordMoves(_record.PlyCount());
+    for (int move = 0; move < _record.PlyCount(); move++) recordMoves[move] = _record.MoveAt(move);
+    return Load(_record.StartFEN(), recordMoves, _record.Result());
+}
+
+bool GameReview::Load(const StoredGame& _game) {
+    return Load(_game.startFEN, _game.moves, _game.result);
+}
+
+void GameReview::Clear() {
+    startFEN.clear();
+    moves.clear();
+    keyframes.clear();
+    undoStates.clear();
+    result = GameResult::ONGOING;
+    ply = undoBase = 0;
+}
+
+void GameReview::LoadKeyframe(int _index) {
+    position.Unpack(keyframes[_index]);
+    ply = undoBase = _index * keyframeInterval;
+    undoStates.clear();
+}
+
+/*
+ * NAVIGATION
+ */
+
+bool GameReview::StepForward() {
+    if (!IsLoaded() || ply >= PlyCount()) return false;
+
+    undoStates.emplace_back();
+    position.Apply(moves[ply], undoStates.back());
+    ply++;
+    return true;
+}
+
+bool GameReview::StepBack() {
+    if (!IsLoaded() || ply == 0) return false;
+
+    // no undo state before the keyframe this run started from
+    if (ply == undoBase) return SeekPly(ply - 1);
+
+    ply--;
+    position.Undo(moves[ply], undoStates.back());
+    undoStates.pop_back();
+    return true;
+}
+
+bool GameReview::SeekPly(int _ply) {
+    if (!IsLoaded()) return false;
+    _ply = std::max(0, std::min(_ply, PlyCount()));
+    if (_ply == ply) return false;
+
+    // Short distances are stepped, anything else starts from the keyframe at or before the target
+    if (_ply > ply && _ply - ply < keyframeInterval) {
+        while (ply < _ply) StepForward();
+        return true;
+    }
+    if (_ply < ply && _ply >= undoBase) {
+        while (ply > _ply) StepBack();
+        return true;
+    }
+
+    LoadKeyframe(_ply / keyframeInterval);
+    while (ply < _ply) StepForward();
+    return true;
+}
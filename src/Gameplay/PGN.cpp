@@ -0,0 +1,402 @@
+//
+// Created by cew05 on 19/10/2026.
+//
+
+#include "include/PGN.h"
+
+#include <algorithm>
+#include <cstring>
+#include <cctype>
+#include <ctime>
+#include <string_view>
+#include <thread>
+
+/*
+ * GAME
+ */
+
+std::string PgnGame::FetchTag(const std::string& _name) const {
+    for (const auto& tag : tags) {
+        if (tag.first == _name) return tag.second;
+    }
+    return {};
+}
+
+void PgnGame::Clear() {
+    tags.clear();
+    startFEN = STANDARD_START_FEN;
+    moves.clear();
+    result = GameResult::ONGOING;
+}
+
+/*
+ * READING
+ */
+
+bool PgnReader::Open(const std::string& _path) {
+    Close();
+
+    if (!pgnFile.OpenRead(_path)) {
+        printf("Failed to open PGN file %s\n", _path.c_str());
+        return false;
+    }
+    return true;
+}
+
+void PgnReader::Close() {
+    pgnFile.Close();
+    gamesRead = 0;
+    gamesRejected = 0;
+}
+
+static bool AtGameStart(const char* _cursor, const char* _begin, const char* _end) {
+    // A game starts with an Event tag at the start of a line
+    return (_cursor == _begin || _cursor[-1] == '\n') && _end - _cursor >= 6 && memcmp(_cursor, "[Event", 6) == 0;
+}
+
+size_t PgnReader::ReadAll(const std::function<void(const PgnGame&)>& _onGame, int _threads) {
+    if (!pgnFile.IsOpen()) return 0;
+
+    const char* begin = (const char*)pgnFile.Data();
+    const char* end = begin + pgnFile.Size();
+
+    // Small files are not worth splitting
+    const uint64_t minBytesPerThread = 1 << 20;
+    _threads = (int)std::max<uint64_t>(1, std::min<uint64_t>(_threads, pgnFile.Size() / minBytesPerThread));
+    if (_threads == 1) return ReadRange(begin, end, _onGame);
+
+    // Split into equal parts, moving each split forwards to the next game
+    std::vector<const char*> splits {begin};
+    for (int t = 1; t < _threads; t++) {
+        const char* split = std::max(begin + pgnFile.Size() * t / _threads, splits.back());
+        while (split < end && !AtGameStart(split, begin, end)) {
+            split = (const char*)memchr(split, '\n', end - split);
+            split = (split == nullptr) ? end : split + 1;
+        }
+        splits.push_back(split);
+    }
+    splits.push_back(end);
+
+    std::vector<std::thread> workers;
+    std::atomic<size_t> total {0};
+    for (int t = 0; t < _threads; t++) {
+        workers.emplace_back([this, &splits, &_onGame, &total, t]() {
+            total += ReadRange(splits[t], splits[t + 1], _onGame);
+        });
+    }
+    for (auto& worker : workers) worker.join();
+
+    return total;
+}
+
+size_t PgnReader::ReadRange(const char* _begin, const char* _end, const std::function<void(const PgnGame&)>& _onGame) {
+    PgnGame game;
+    size_t valid = 0;
+    const char* cursor = _begin;
+
+    while (cursor < _end) {
+        // nothing left but whitespace
+        while (cursor < _end && std::isspace((unsigned char)*cursor)) cursor++;
+        if (cursor >= _end) break;
+
+        game.Clear();
+        bool ok = ParseGame(cursor, _end, game);
+        if (!ok) {
+            gamesRejected++;
+            continue;
+        }
+
+        gamesRead++;
+        valid++;
+        _onGame(game);
+    }
+
+    return valid;
+}
+
+// Character classes of the tokeniser, without the locale lookups of <cctype> as they run on every byte
+static bool IsSpace(char _c) {
+    return _c == ' ' || _c == '\n' || _c == '\r' || _c == '\t' || _c == '\v' || _c == '\f';
+}
+
+static bool EndsToken(char _c) {
+    switch (_c) {
+        case '{': case '}': case '(': case ')': case ';': case '[': return true;
+        default: return IsSpace(_c);
+    }
+}
+
+static void SkipWhitespace(const char*& _cursor, const char* _end) {
+    while (_cursor < _end && IsSpace(*_cursor)) _cursor++;
+}
+
+static void SkipLine(const char*& _cursor, const char* _end) {
+    const char* newline = (const char*)memchr(_cursor, '\n', _end - _cursor);
+    _cursor = (newline == nullptr) ? _end : newline + 1;
+}
+
+static void SkipComment(const char*& _cursor, const char* _end) {
+    // _cursor is on the opening brace, comments do not nest
+    const char* close = (const char*)memchr(_cursor, '}', _end - _cursor);
+    _cursor = (close == nullptr) ? _end : close + 1;
+}
+
+static void SkipVariation(const char*& _cursor, const char* _end) {
+    // _cursor is on the opening bracket, variations nest and may hold comments
+    int depth = 0;
+    while (_cursor < _end) {
+        char c = *_cursor;
+        if (c == '{') {
+            SkipComment(_cursor, _end);
+            continue;
+        }
+        if (c == ';') {
+            SkipLine(_cursor, _end);
+            continue;
+        }
+
+        _cursor++;
+        if (c == '(') depth++;
+        else if (c == ')' && --depth == 0) return;
+    }
+}
+
+static bool ParseTag(const char*& _cursor, const char* _end, PgnGame& _game) {
+    // [Name "Value"], the value may contain escaped quotes and backslashes
+    _cursor++;
+    SkipWhitespace(_cursor, _end);
+
+    const char* nameStart = _cursor;
+    while (_cursor < _end && (std::isalnum((unsigned char)*_cursor) || *_cursor == '_')) _cursor++;
+    std::string name(nameStart, _cursor);
+
+    SkipWhitespace(_cursor, _end);
+    if (_cursor >= _end || *_cursor != '"') {
+        SkipLine(_cursor, _end);
+        return false;
+    }
+    _cursor++;
+
+    std::string value;
+    while (_cursor < _end && *_cursor != '"') {
+        if (*_cursor == '\\' && _cursor + 1 < _end) _cursor++;
+        value += *_cursor++;
+    }
+
+    const char* close = (const char*)memchr(_cursor, ']', _end - _cursor);
+    _cursor = (close == nullptr) ? _end : close + 1;
+
+    _game.tags.emplace_back(std::move(name), std::move(value));
+    return true;
+}
+
+bool PgnReader::ParseGame(const char*& _cursor, const char* _end, PgnGame& _game) {
+    /*
+     * Reads the tag section then the movetext up to the result token. A game whose result is missing ends where the next
+     * game's tags begin. Moves after an invalid move are skipped, and the game is rejected
+     */
+
+    const char* begin = _cursor;
+    bool valid = true;
+
+    // Tag pairs
+    SkipWhitespace(_cursor, _end);
+    while (_cursor < _end && (*_cursor == '[' || *_cursor == '%')) {
+        if (*_cursor == '%') SkipLine(_cursor, _end);
+        else ParseTag(_cursor, _end, _game);
+        SkipWhitespace(_cursor, _end);
+    }
+
+    std::string fen = _game.FetchTag("FEN");
+    if (!fen.empty()) _game.startFEN = fen;
+
+    Position position;
+    if (!position.FromFEN(_game.startFEN)) valid = false;
+
+    // Movetext
+    bool sawMovetext = false;
+    while (_cursor < _end) {
+        SkipWhitespace(_cursor, _end);
+        if (_cursor >= _end) break;
+
+        char c = *_cursor;
+
+        // next game's tags, no result token was given
+        if (c == '[' && sawMovetext && AtGameStart(_cursor, begin, _end)) break;
+
+        if (c == '{') { SkipComment(_cursor, _end); continue; }
+        if (c == ';') { SkipLine(_cursor, _end); continue; }
+        if (c == '(') { SkipVariation(_cursor, _end); continue; }
+        if (c == '%' && (_cursor == begin || _cursor[-1] == '\n')) { SkipLine(_cursor, _end); continue; }
+
+        // token up to the next delimiter
+        const char* tokenStart = _cursor;
+        while (_cursor < _end && !EndsToken(*_cursor)) _cursor++;
+        size_t length = _cursor - tokenStart;
+        if (length == 0) {
+            _cursor++;
+            continue;
+        }
+        sawMovetext = true;
+
+        // NAGs
+        if (c == '$') continue;
+
+        // results end the game
+        std::string_view token(tokenStart, length);
+        if (token == "1-0") { _game.result = GameResult::WHITE_WIN; break; }
+        if (token == "0-1") { _game.result = GameResult::BLACK_WIN; break; }
+        if (token == "1/2-1/2") { _game.result = GameResult::DRAW; break; }
+        if (token == "*") break;
+
+        // move numbers, "12." or "12..." possibly joined to the move as "12.e4"
+        size_t start = 0;
+        while (start < token.length() && std::isdigit((unsigned char)token[start])) start++;
+        if (start > 0 && start < token.length() && token[start] == '.') {
+            while (start < token.length() && token[start] == '.') start++;
+        } else {
+            start = 0;
+        }
+        if (start == token.length()) continue;
+
+        if (!valid) continue;
+        Move16 move = position.ParseSAN(std::string(token.substr(start)));
+        if (move == Position::MOVE_NONE) {
+            valid = false;
+            continue;
+        }
+
+        position.Apply(move);
+        _game.moves.push_back(move);
+    }
+
+    return valid && sawMovetext;
+}
+
+/*
+ * WRITING
+ */
+
+std::string PgnWriter::ResultString(GameResult _result) {
+    switch (_result) {
+        case GameResult::WHITE_WIN: return "1-0";
+        case GameResult::BLACK_WIN: return "0-1";
+        case GameResult::DRAW: return "1/2-1/2";
+        default: return "*";
+    }
+}
+
+std::string PgnWriter::FormatGame(const PgnGame& _game) {
+    /*
+     * Seven tag roster first with "?" for missing tags, then any other tags, then the movetext wrapped at 80 columns
+     */
+
+    std::string pgn;
+    const char* roster[] = {"Event", "Site", "Date", "Round", "White", "Black", "Result"};
+
+    auto escape = [](const std::string& _value) {
+        std::string escaped;
+        for (char c : _value) {
+            if (c == '"' || c == '\\') escaped += '\\';
+            escaped += c;
+        }
+        return escaped;
+    };
+
+    for (const char* name : roster) {
+        std::string value = (std::string(name) == "Result") ? ResultString(_game.result) : _game.FetchTag(name);
+        if (value.empty()) value = "?";
+        pgn += std::string("[") + name + " \"" + escape(value) + "\"]\n";
+    }
+    for (const auto& tag : _game.tags) {
+        if (std::find(std::begin(roster), std::end(roster), tag.first) != std::end(roster)) continue;
+        if (tag.first == "FEN" || tag.first == "SetUp") continue;
+        pgn += "[" + tag.first + " \"" + escape(tag.second) + "\"]\n";
+    }
+    if (_game.startFEN != STANDARD_START_FEN) {
+        pgn += "[SetUp \"1\"]\n[FEN \"" + _game.startFEN + "\"]\n";
+    }
+    pgn += "\n";
+
+    Position position;
+    if (!position.FromFEN(_game.startFEN)) return {};
+
+    std::string line;
+    auto addToken = [&](const std::string& _token) {
+        if (!line.empty() && line.length() + 1 + _token.length() > 80) {
+            pgn += line + "\n";
+            line.clear();
+        }
+        if (!line.empty()) line += ' ';
+        line += _token;
+    };
+
+    for (size_t m = 0; m < _game.moves.size(); m++) {
+        if (position.SideToMove() == 'w') addToken(std::to_string(position.FullMove()) + ".");
+        else if (m == 0) addToken(std::to_string(position.FullMove()) + "...");
+
+        addToken(position.ToSAN(_game.moves[m]));
+        position.Apply(_game.moves[m]);
+    }
+    addToken(ResultString(_game.result));
+    pgn += line + "\n\n";
+
+    return pgn;
+}
+
+bool PgnWriter::WriteGame(const PgnGame& _game, const std::string& _path, bool _append) {
+    std::string pgn = FormatGame(_game);
+    if (pgn.empty()) return false;
+
+    FILE* file = fopen(_path.c_str(), _append ? "ab" : "wb");
+    if (file == nullptr) {
+        printf("Failed to open PGN file %s\n", _path.c_str());
+        return false;
+    }
+
+    bool ok = fwrite(pgn.data(), 1, pgn.size(), file) == pgn.size();
+    ok = (fclose(file) == 0) && ok;
+    return ok;
+}
+
+void PgnWriter::AddRecordTags(PgnGame& _game, int64_t _startTime, const std::string& _metadata) {
+    // Date tag from the record's start time, localtime's shared buffer is avoided as games are exported from any thread
+    char date[16];
+    time_t startTime = (time_t)_startTime;
+    std::tm startDate {};
+#ifdef _WIN32
+    localtime_s(&startDate, &startTime);
+#else
+    localtime_r(&startTime, &startDate);
+#endif
+    std::strftime(date, sizeof(date), "%Y.%m.%d", &startDate);
+    _game.tags.emplace_back("Date", date);
+
+    size_t lineStart = 0, lineEnd;
+    while ((lineEnd = _metadata.find('\n', lineStart)) != std::string::npos) {
+        std::string line = _metadata.substr(lineStart, lineEnd - lineStart);
+        size_t split = line.find('=');
+        if (split != std::string::npos) _game.tags.emplace_back(line.substr(0, split), line.substr(split + 1));
+        lineStart = lineEnd + 1;
+    }
+}
+
+PgnGame PgnWriter::FromRecord(const GameRecord& _record) {
+    PgnGame game;
+    game.startFEN = _record.StartFEN();
+    game.result = _record.Result();
+    game.moves = _record.Moves();
+    AddRecordTags(game, _record.StartTime(), _record.Metadata());
+
+    return game;
+}
+
+PgnGame PgnWriter::FromRecord(const GameRecordReader& _record) {
+    PgnGame game;
+    game.startFEN = _record.StartFEN();
+    game.result = _record.Result();
+    for (int ply = 0; ply < _record.PlyCount(); ply++) game.moves.push_back(_record.MoveAt(ply));
+    AddRecordTags(game, _record.StartTime(), _record.Metadata());
+
+    return game;
+}
@@ -48,8 +48,15 @@ int Piece::CreateTextures() {
      */
 
     // Load TextureID for piece
+    info->textureID = TextureIDOf(info->pieceID, info->colID);
+    tm->OpenTexture(info->textureID);
+
+    return 0;
+}
+
+TextureID Piece::TextureIDOf(char _pieceID, char _colID) {
     TextureID t;
-    switch (info->pieceID) {
+    switch (_pieceID) {
         case 'K': t = WHITE_KING; break;
         case 'Q': t = WHITE_QUEEN; break;
         case 'R': t = WHITE_ROOK; break;
@@ -57,10 +64,7 @@ int Piece::CreateTextures() {
         case 'N': t = WHITE_KNIGHT; break;
         default: t = WHITE_PAWN; break;
     }
-    info->textureID = TextureID(t + (info->colID == 'W' ? 0 : 1) + PIECE_STYLE.second);
-    tm->OpenTexture(info->textureID);
-
-    return 0;
+    return TextureID(t + (_colID == 'W' ? 0 : 1) + PIECE_STYLE.second);
 }
 
 void Piece::SetRects(const std::unique_ptr<Board> &_board) {
@@ -80,95 +84,86 @@ void Piece::GetRectOfBoardPosition(const std::unique_ptr<Board> &_board) {
 
 // Displaying Piece / Moves
 
-void Piece::DisplayPiece(const std::unique_ptr<Board> &_board) {
-    // Don't display piece if captured
+void Piece::FillSnapshot(PieceSnapshot& _snapshot) const {
+    _snapshot.textureID = info->textureID;
+    _snapshot.gamepos = info->gamepos;
+    _snapshot.lastpos = info->lastpos;
+    _snapshot.selected = selected;
+    _snapshot.heldClick = heldClick;
+    _snapshot.showLastMove = lastMoveDisplayTimer > 0;
+    _snapshot.animStartTick = animStartTick;
+    _snapshot.animLenTicks = animLenTicks;
+}
+
+void Piece::FetchMoveHints(std::vector<MoveHint>& _hints) const {
+    /*
+     * Adds a marker for each of the valid moves listed in the validMoves vector. Only called for the selected piece
+     */
+
     if (captured) return;
 
+    for (const AvailableMove& move : validMoves) {
+        // if the move is a capture (except if capturing same team rook as this is a castling move) then use diff icon
+        int moveIcon = ATLAS_MOVE;
+        if (move.GetTarget() != nullptr) {
+            if (move.GetTarget()->GetPieceInfoPtr()->colID != info->colID) {
+                moveIcon = ATLAS_CAPTURE;
+            }
+        }
+
+        _hints.push_back({move.GetPosition(), moveIcon});
+    }
+}
+
+void Piece::DisplaySnapshot(const PieceSnapshot& _snapshot, const std::unique_ptr<Board>& _board,
+                            SpriteBatch& _batch) {
+    /*
+     * Rects are taken from the board layout each frame, so the snapshot stays valid across resizes and flips
+     */
+
     // temp vars
-    SDL_Texture* texture;
-    SDL_Rect rect;
+    SDL_Rect rect, boardRect;
+    _board->GetBorderedRectFromPosition(boardRect, _snapshot.gamepos);
 
-    if(selected) {
-        texture = tm->AccessTexture(SELECTED);
-        rm->FetchResource(rect, RectID::BOARDPOS_RECT);
-        SDL_RenderCopy(window.renderer, texture, nullptr, &rect);
+    if (_snapshot.selected) {
+        _batch.Add(GetAtlasRect(ATLAS_SELECTED), boardRect);
     }
 
-    // Show the move made by the piece if it just moved
-    if (lastMoveDisplayTimer > 0) {
+    // Show the move made by the piece if it just moved, as tinted quads of the solid atlas cell
+    if (_snapshot.showLastMove) {
         // last position
-        _board->GetTileRectFromPosition(rect, info->lastpos);
-        SDL_SetRenderDrawColor(window.renderer, 0, 0, 0, 75);
-        SDL_RenderFillRect(window.renderer, &rect);
-        SDL_SetRenderDrawColor(window.renderer, 0, 0, 0, 0);
+        _board->GetTileRectFromPosition(rect, _snapshot.lastpos);
+        _batch.Add(GetAtlasRect(ATLAS_SOLID), rect, {0, 0, 0, 75});
 
         // new position
-        _board->GetTileRectFromPosition(rect, info->gamepos);
-        SDL_SetRenderDrawColor(window.renderer, 0, 0, 0, 125);
-        SDL_RenderFillRect(window.renderer, &rect);
-        SDL_SetRenderDrawColor(window.renderer, 0, 0, 0, 0);
+        _board->GetTileRectFromPosition(rect, _snapshot.gamepos);
+        _batch.Add(GetAtlasRect(ATLAS_SOLID), rect, {0, 0, 0, 125});
     }
 
-    // Change the PIECE_RECT values over time to produce animation of movement to the new position
-    if (frameTick.currTick < animStartTick + animLenTicks) {
-        SDL_Rect oldPos, newPos, pieceRect;
-        _board->GetBorderedRectFromPosition(oldPos, info->lastpos);
-        _board->GetBorderedRectFromPosition(newPos, info->gamepos);
+    rect = boardRect;
 
-        double dx = double(newPos.x - oldPos.x) / animLenTicks;
-        double dy = double(newPos.y - oldPos.y) / animLenTicks;
+    // Move the piece rect over time to produce animation of movement to the new position
+    if (frameTick.currTick < _snapshot.animStartTick + _snapshot.animLenTicks) {
+        SDL_Rect oldPos;
+        _board->GetBorderedRectFromPosition(oldPos, _snapshot.lastpos);
 
-        pieceRect = oldPos;
-        pieceRect.x += int(dx * int(frameTick.currTick - animStartTick));
-        pieceRect.y += int(dy * int(frameTick.currTick - animStartTick));
+        double dx = double(boardRect.x - oldPos.x) / _snapshot.animLenTicks;
+        double dy = double(boardRect.y - oldPos.y) / _snapshot.animLenTicks;
 
-        rm->ChangeResource(pieceRect, PIECE_RECT);
-    } else {
-        SetRects(_board);
+        rect = oldPos;
+        rect.x += int(dx * int(frameTick.currTick - _snapshot.animStartTick));
+        rect.y += int(dy * int(frameTick.currTick - _snapshot.animStartTick));
     }
 
-    rm->FetchResource(rect, RectID::PIECE_RECT);
-
     // Check if mouse dragging piece
-    if (heldClick) {
-        SDL_Rect boardRect;
-        rm->FetchResource(boardRect, RectID::BOARDPOS_RECT);
-        rm->FetchResource(rect, RectID::PIECE_RECT);
+    if (_snapshot.heldClick) {
         rect.w = boardRect.w * 4/3;
         rect.h = boardRect.h * 4/3;
         rect.x = mouse.GetMousePosition().first - rect.w/2;
         rect.y = mouse.GetMousePosition().second - rect.h/2;
-        rm->ChangeResource(rect, RectID::PIECE_RECT);
-    }
-    else {
-        SetRects(_board);
     }
 
-    texture = tm->AccessTexture(info->textureID);
-    SDL_RenderCopy(window.renderer, texture, nullptr, &rect);
-}
-
-void Piece::DisplayMoves(const std::unique_ptr<Board> &_board) {
-    /*
-     * When the piece is selected, will display the valid moves listed in the validMoves vector
-     */
-
-    if (!selected || captured) return;
-
-    for (const AvailableMove& move : validMoves) {
-        SDL_Rect moveRect = {0, 0};
-        _board->GetBorderedRectFromPosition(moveRect, move.GetPosition());
-
-        // if the move is a capture (except if capturing same team rook as this is a castling move) then use diff icon
-        SDL_Texture* moveIcon = tm->AccessTexture(MOVE);
-        if (move.GetTarget() != nullptr) {
-            if (move.GetTarget()->GetPieceInfoPtr()->colID != info->colID) {
-                moveIcon = tm->AccessTexture(CAPTURE);
-            }
-        }
-
-        SDL_RenderCopy(window.renderer, moveIcon, nullptr, &moveRect);
-    }
+    _batch.Add(GetAtlasRect(GetPieceAtlasCell(_snapshot.textureID)), rect);
 }
 
 /*
@@ -434,8 +429,10 @@ void Piece::MoveTo(std::pair<char, int> _movepos, const std::unique_ptr<Board> &
     info->gamepos = _movepos;
     hasMoved = true;
 
-    // Start animation
-    animStartTick = frameTick.currTick;
+    // Start animation, keep frames drawing until it has finished. May run on the simulation thread, so the tick is read
+    // directly rather than from frameTick
+    animStartTick = SDL_GetTicks64();
+    framePacer.KeepAwake(animLenTicks);
 
     // Remake rect
     SetRects(_board);
@@ -499,7 +496,11 @@ Piece* Piece::GetPromotedTo() const {
  * SELECTING PIECES
  */
 
-void Piece::UpdateClickedStatus(const std::vector<std::unique_ptr<Piece>> &_teamPieces) {
+void Piece::UpdateClickedStatus(bool _otherClicked, bool _mouseOnSquare) {
+    /*
+     * _mouseOnSquare is whether the mouse is over this piece's square, resolved once per frame by the caller
+     */
+
     if (captured) {
         clicked = false;
         heldClick = false;
@@ -507,35 +508,25 @@ void Piece::UpdateClickedStatus(const std::vector<std::unique_ptr<Piece>> &_team
         return;
     }
 
-    SDL_Rect boardRect, pieceRect;
-    rm->FetchResource(boardRect, RectID::BOARDPOS_RECT);
-    rm->FetchResource(pieceRect, RectID::PIECE_RECT);
-
     // Assume not clicked
     clicked = false;
 
     // if another piece is currently clicked, ignore any attempt to click on current piece
-    for (const auto& piece : _teamPieces) {
-        if (piece.get() == this) continue;
-
-        if (piece->IsClicked()) {
-            return;
-        }
-    }
+    if (_otherClicked) return;
 
     // mousedown over the boardpos
-    if (mouse.IsUnheldActive() && mouse.InRect(boardRect)) {
+    if (mouse.IsUnheldActive() && _mouseOnSquare) {
         heldClick = true;
         clicked = true;
     }
 
-    // mouse held down dragging piece
-    if (heldClick && mouse.InRect(pieceRect)) {
+    // mouse held down dragging piece, the piece follows the mouse when drawn so it stays clicked wherever it is held
+    if (heldClick && mouse.IsHeldActive()) {
         clicked = true;
     }
 
     // mousedown released over boardpos
-    if (heldClick && mouse.ClickOnRelease(boardRect)) {
+    if (heldClick && mouse.IsReleased() && _mouseOnSquare) {
         heldClick = false;
         clicked = true;
     }
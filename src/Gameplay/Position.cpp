@@ -0,0 +1,789 @@
+//
+// Created by cew05 on 19/10/2026.
+//
+
+#include "include/Position.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
+// Nibble codes of the packed board, bit 3 marks a black piece
+static const char* PACKED_PIECES = ".PNBRQK..pnbrqk";
+
+static uint8_t PackPiece(char _piece) {
+    if (_piece == 0) return 0;
+    const char* found = strchr(PACKED_PIECES + 1, _piece);
+    return found ? uint8_t(found - PACKED_PIECES) : 0;
+}
+
+// Board squares only ever hold piece letters, so these skip the locale lookups of <cctype> on the hot paths
+static bool IsWhitePiece(char _piece) {
+    return _piece >= 'A' && _piece <= 'Z';
+}
+
+static char PieceType(char _piece) {
+    return IsWhitePiece(_piece) ? char(_piece + ('a' - 'A')) : _piece;
+}
+
+bool Position::FromFEN(const std::string& _fen) {
+    /*
+     * Reads all six FEN fields, the move counters may be omitted. Returns false if the placement field is malformed
+     */
+
+    std::istringstream ss(_fen);
+    std::string placement, side, castle, ep;
+    ss >> placement >> side >> castle >> ep;
+
+    board.fill(0);
+    int rank = 8, file = 0;
+    for (char c : placement) {
+        // every rank must cover exactly eight files
+        if (c == '/') {
+            if (file != 8 || rank == 1) return false;
+            rank--;
+            file = 0;
+            continue;
+        }
+        if (c >= '1' && c <= '8') {
+            file += c - '0';
+            if (file > 8) return false;
+            continue;
+        }
+        if (strchr("PNBRQKpnbrqk", c) == nullptr || file > 7) return false;
+
+        board[(rank - 1) * 8 + file] = c;
+        file++;
+    }
+    if (rank != 1 || file != 8) return false;
+    FindKings();
+
+    sideToMove = (side == "b") ? 'b' : 'w';
+
+    castling = 0;
+    for (char c : castle) {
+        if (c == 'K') castling |= WHITE_KINGSIDE;
+        if (c == 'Q') castling |= WHITE_QUEENSIDE;
+        if (c == 'k') castling |= BLACK_KINGSIDE;
+        if (c == 'q') castling |= BLACK_QUEENSIDE;
+    }
+
+    epSquare = (ep.length() == 2) ? Square(ep[0], ep[1] - '0') : NO_SQUARE;
+    if (epSquare < 0 || epSquare >= 64) epSquare = NO_SQUARE;
+
+    halfmoveClock = 0;
+    fullmove = 1;
+    ss >> halfmoveClock >> fullmove;
+
+    return true;
+}
+
+std::string Position::ToFEN() const {
+    std::string fen;
+
+    for (int rank = 8; rank >= 1; rank--) {
+        int empty = 0;
+        for (int file = 0; file < 8; file++) {
+            char piece = board[(rank - 1) * 8 + file];
+            if (piece == 0) {
+                empty++;
+                continue;
+            }
+            if (empty > 0) fen += std::to_string(empty);
+            empty = 0;
+            fen += piece;
+        }
+        if (empty > 0) fen += std::to_string(empty);
+        if (rank > 1) fen += '/';
+    }
+
+    fen += FENState(sideToMove, castling, epSquare, halfmoveClock, fullmove);
+    return fen;
+}
+
+std::string Position::FENState(char _sideToMove, uint8_t _castling, int _epSquare, int _halfmoveClock, int _fullmove) {
+    /*
+     * Every FEN field after the placement, shared with Board::CreateFEN so both write them the same way
+     */
+
+    std::string fields = " ";
+    fields += _sideToMove;
+    fields += ' ';
+
+    if (_castling == 0) fields += '-';
+    if (_castling & WHITE_KINGSIDE) fields += 'K';
+    if (_castling & WHITE_QUEENSIDE) fields += 'Q';
+    if (_castling & BLACK_KINGSIDE) fields += 'k';
+    if (_castling & BLACK_QUEENSIDE) fields += 'q';
+
+    fields += ' ';
+    if (_epSquare == NO_SQUARE) fields += '-';
+    else {
+        fields += char('a' + _epSquare % 8);
+        fields += std::to_string(_epSquare / 8 + 1);
+    }
+
+    fields += " " + std::to_string(_halfmoveClock) + " " + std::to_string(_fullmove);
+    return fields;
+}
+
+Move16 Position::EncodeMove(int _from, int _to, int _flag, char _promoteTo) {
+    int promo = 3;
+    switch (std::tolower(_promoteTo)) {
+        case 'n': promo = 0; break;
+        case 'b': promo = 1; break;
+        case 'r': promo = 2; break;
+        default: break;
+    }
+
+    return Move16((_flag << 14) | (promo << 12) | (_from << 6) | _to);
+}
+
+Move16 Position::ParseUCI(const std::string& _uci) const {
+    /*
+     * Converts a UCI move to a Move16, working out the special move flag from the pieces involved. Castling is the
+     * kings two square move. Returns MOVE_NONE if the string is malformed or there is no piece on the origin square
+     */
+
+    if (_uci.length() < 4) return MOVE_NONE;
+    if (_uci[0] < 'a' || _uci[0] > 'h' || _uci[2] < 'a' || _uci[2] > 'h') return MOVE_NONE;
+    if (_uci[1] < '1' || _uci[1] > '8' || _uci[3] < '1' || _uci[3] > '8') return MOVE_NONE;
+
+    int from = Square(_uci[0], _uci[1] - '0');
+    int to = Square(_uci[2], _uci[3] - '0');
+    char piece = PieceType(board[from]);
+    if (piece == 0 || from == to) return MOVE_NONE;
+
+    if (_uci.length() > 4 && std::isalpha(_uci[4])) return EncodeMove(from, to, PROMOTION, _uci[4]);
+    if (piece == 'k' && std::abs(to - from) == 2) return EncodeMove(from, to, CASTLING);
+    if (piece == 'p' && (from % 8) != (to % 8) && board[to] == 0) return EncodeMove(from, to, EN_PASSANT);
+
+    return EncodeMove(from, to);
+}
+
+std::string Position::ToUCI(Move16 _move) {
+    std::string uci;
+    uci += char('a' + MoveFrom(_move) % 8);
+    uci += char('1' + MoveFrom(_move) / 8);
+    uci += char('a' + MoveTo(_move) % 8);
+    uci += char('1' + MoveTo(_move) / 8);
+    if (MoveFlagOf(_move) == PROMOTION) uci += MovePromotion(_move);
+
+    return uci;
+}
+
+void Position::Apply(Move16 _move) {
+    /*
+     * Plays the move without checking that it is legal, updating castling rights, en passant and the move counters
+     */
+
+    int from = MoveFrom(_move), to = MoveTo(_move), flag = MoveFlagOf(_move);
+    char piece = board[from];
+    char type = PieceType(piece);
+    bool white = IsWhitePiece(piece);
+    bool capture = board[to] != 0;
+
+    board[to] = piece;
+    board[from] = 0;
+    if (piece == 'K') kings[0] = to;
+    if (piece == 'k') kings[1] = to;
+
+    switch (flag) {
+        case PROMOTION:
+            board[to] = white ? (char)std::toupper(MovePromotion(_move)) : MovePromotion(_move);
+            break;
+
+        case EN_PASSANT:
+            // captured pawn is behind the destination square
+            board[white ? to - 8 : to + 8] = 0;
+            capture = true;
+            break;
+
+        case CASTLING:
+            // rook jumps over the king
+            if (to > from) {
+                board[from + 1] = board[from + 3];
+                board[from + 3] = 0;
+            } else {
+                board[from - 1] = board[from - 4];
+                board[from - 4] = 0;
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    // Castling rights are lost once the king or rook moves, or the rook is captured
+    if (type == 'k') castling &= white ? ~(WHITE_KINGSIDE | WHITE_QUEENSIDE) : ~(BLACK_KINGSIDE | BLACK_QUEENSIDE);
+    for (int square : {from, to}) {
+        if (square == 0) castling &= ~WHITE_QUEENSIDE;
+        if (square == 7) castling &= ~WHITE_KINGSIDE;
+        if (square == 56) castling &= ~BLACK_QUEENSIDE;
+        if (square == 63) castling &= ~BLACK_KINGSIDE;
+    }
+
+    epSquare = (type == 'p' && std::abs(to - from) == 16) ? (from + to) / 2 : NO_SQUARE;
+    halfmoveClock = (type == 'p' || capture) ? 0 : halfmoveClock + 1;
+    if (sideToMove == 'b') fullmove++;
+    sideToMove = (sideToMove == 'w') ? 'b' : 'w';
+}
+
+void Position::Apply(Move16 _move, UndoState& _undo) {
+    int to = MoveTo(_move);
+    bool white = sideToMove == 'w';
+
+    _undo.captured = (MoveFlagOf(_move) == EN_PASSANT) ? (white ? 'p' : 'P') : board[to];
+    _undo.castling = castling;
+    _undo.epSquare = epSquare;
+    _undo.halfmoveClock = halfmoveClock;
+    Apply(_move);
+}
+
+void Position::Undo(Move16 _move, const UndoState& _undo) {
+    /*
+     * Takes back the last move applied, which must have been applied with the same UndoState
+     */
+
+    int from = MoveFrom(_move), to = MoveTo(_move), flag = MoveFlagOf(_move);
+    char piece = board[to];
+    bool white = IsWhitePiece(piece);
+    if (flag == PROMOTION) piece = white ? 'P' : 'p';
+
+    board[from] = piece;
+    board[to] = (flag == EN_PASSANT) ? 0 : _undo.captured;
+    if (piece == 'K') kings[0] = from;
+    if (piece == 'k') kings[1] = from;
+
+    if (flag == EN_PASSANT) board[white ? to - 8 : to + 8] = _undo.captured;
+    if (flag == CASTLING) {
+        if (to > from) {
+            board[from + 3] = board[from + 1];
+            board[from + 1] = 0;
+        } else {
+            board[from - 4] = board[from - 1];
+            board[from - 1] = 0;
+        }
+    }
+
+    castling = _undo.castling;
+    epSquare = _undo.epSquare;
+    halfmoveClock = _undo.halfmoveClock;
+    if (sideToMove == 'w') fullmove--;
+    sideToMove = (sideToMove == 'w') ? 'b' : 'w';
+}
+
+void Position::Pack(PackedPosition& _packed) const {
+    memset(&_packed, 0, sizeof(_packed));
+
+    for (int square = 0; square < 64; square += 2) {
+        _packed.squares[square / 2] = uint8_t(PackPiece(board[square]) | (PackPiece(board[square + 1]) << 4));
+    }
+    _packed.sideToMove = (sideToMove == 'b') ? 1 : 0;
+    _packed.castling = castling;
+    _packed.epSquare = uint8_t(epSquare);
+    _packed.halfmoveClock = uint8_t(std::min(halfmoveClock, 255));
+    _packed.fullmove = uint16_t(fullmove);
+}
+
+void Position::Unpack(const PackedPosition& _packed) {
+    for (int square = 0; square < 64; square += 2) {
+        char low = PACKED_PIECES[_packed.squares[square / 2] & 15];
+        char high = PACKED_PIECES[_packed.squares[square / 2] >> 4];
+        board[square] = (low == '.') ? 0 : low;
+        board[square + 1] = (high == '.') ? 0 : high;
+    }
+    sideToMove = _packed.sideToMove ? 'b' : 'w';
+    castling = _packed.castling;
+    epSquare = (_packed.epSquare < 64) ? _packed.epSquare : NO_SQUARE;
+    halfmoveClock = _packed.halfmoveClock;
+    fullmove = _packed.fullmove;
+    FindKings();
+}
+
+/*
+ * HASHING
+ */
+
+// Zobrist keys: 12 piece kinds on 64 squares, then castling rights, en passant file and side to move
+static const int ZOBRIST_CASTLING = 768, ZOBRIST_PASSANT = 784, ZOBRIST_TURN = 792;
+
+static const std::array<uint64_t, 793>& ZobristKeys() {
+    static const std::array<uint64_t, 793> keys = [] {
+        std::array<uint64_t, 793> generated {};
+        uint64_t state = 0x43685344'4C6B6579ULL;
+
+        // splitmix64, fixed seed so keys stored in game databases stay valid
+        for (uint64_t& key : generated) {
+            uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            key = z ^ (z >> 31);
+        }
+        return generated;
+    }();
+    return keys;
+}
+
+uint64_t Position::Key() const {
+    const std::array<uint64_t, 793>& keys = ZobristKeys();
+    uint64_t key = 0;
+
+    for (int square = 0; square < 64; square++) {
+        if (board[square] == 0) continue;
+        uint8_t code = PackPiece(board[square]);
+        int kind = (code & 7) - 1 + ((code & 8) ? 6 : 0);
+        key ^= keys[kind * 64 + square];
+    }
+    key ^= keys[ZOBRIST_CASTLING + castling];
+
+    // en passant only counts when a pawn can take, so transposed move orders reach the same key
+    if (epSquare != NO_SQUARE) {
+        bool white = sideToMove == 'w';
+        int pawnRank = white ? 4 : 3, file = epSquare % 8;
+        char pawn = white ? 'P' : 'p';
+        if ((file > 0 && board[pawnRank * 8 + file - 1] == pawn) || (file < 7 && board[pawnRank * 8 + file + 1] == pawn))
+            key ^= keys[ZOBRIST_PASSANT + file];
+    }
+
+    if (sideToMove == 'b') key ^= keys[ZOBRIST_TURN];
+    return key;
+}
+
+/*
+ * RULES
+ */
+
+// {file, rank} steps
+static const int KNIGHT_STEPS[8][2] = {{1, 2}, {2, 1}, {2, -1}, {1, -2}, {-1, -2}, {-2, -1}, {-2, 1}, {-1, 2}};
+static const int KING_STEPS[8][2] = {{1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}, {-1, -1}, {0, -1}, {1, -1}};
+
+static bool OnBoard(int _file, int _rank) {
+    return _file >= 0 && _file < 8 && _rank >= 0 && _rank < 8;
+}
+
+// Per square lookups of the steps above, so attack tests do no bounds checks. Rays follow KING_STEPS' directions
+struct StepTables {
+    uint8_t knightTargets[64][8];
+    uint8_t knightCount[64];
+    uint8_t rayLength[64][8];
+    int rayDelta[8];
+};
+
+static const StepTables& Steps() {
+    static const StepTables tables = [] {
+        StepTables generated {};
+
+        for (int dir = 0; dir < 8; dir++) generated.rayDelta[dir] = KING_STEPS[dir][1] * 8 + KING_STEPS[dir][0];
+
+        for (int square = 0; square < 64; square++) {
+            int file = square % 8, rank = square / 8;
+
+            for (const auto& step : KNIGHT_STEPS) {
+                int f = file + step[0], r = rank + step[1];
+                if (OnBoard(f, r)) generated.knightTargets[square][generated.knightCount[square]++] = uint8_t(r * 8 + f);
+            }
+
+            for (int dir = 0; dir < 8; dir++) {
+                int f = file + KING_STEPS[dir][0], r = rank + KING_STEPS[dir][1];
+                while (OnBoard(f, r)) {
+                    generated.rayLength[square][dir]++;
+                    f += KING_STEPS[dir][0];
+                    r += KING_STEPS[dir][1];
+                }
+            }
+        }
+        return generated;
+    }();
+    return tables;
+}
+
+bool Position::IsOwnPiece(int _square, bool _white) const {
+    char piece = board[_square];
+    return piece != 0 && IsWhitePiece(piece) == _white;
+}
+
+void Position::FindKings() {
+    kings[0] = kings[1] = NO_SQUARE;
+    for (int square = 0; square < 64; square++) {
+        if (board[square] == 'K') kings[0] = square;
+        if (board[square] == 'k') kings[1] = square;
+    }
+}
+
+int Position::FindKing(bool _white) const {
+    return kings[_white ? 0 : 1];
+}
+
+bool Position::IsSquareAttacked(int _square, bool _byWhite) const {
+    const StepTables& steps = Steps();
+    int file = _square % 8, rank = _square / 8;
+
+    // Pawns attack diagonally forwards, so look one rank behind the square
+    int pawnRank = _byWhite ? rank - 1 : rank + 1;
+    for (int df : {-1, 1}) {
+        if (OnBoard(file + df, pawnRank) && board[pawnRank * 8 + file + df] == (_byWhite ? 'P' : 'p')) return true;
+    }
+
+    char knight = _byWhite ? 'N' : 'n';
+    for (int step = 0; step < steps.knightCount[_square]; step++) {
+        if (board[steps.knightTargets[_square][step]] == knight) return true;
+    }
+
+    char king = _byWhite ? 'K' : 'k', queen = _byWhite ? 'Q' : 'q';
+    for (int dir = 0; dir < 8; dir++) {
+        int length = steps.rayLength[_square][dir];
+        if (length == 0) continue;
+
+        int delta = steps.rayDelta[dir];
+        if (board[_square + delta] == king) return true;
+
+        // Sliders along the same direction, rooks orthogonally and bishops diagonally
+        bool diagonal = KING_STEPS[dir][0] != 0 && KING_STEPS[dir][1] != 0;
+        char slider = _byWhite ? (diagonal ? 'B' : 'R') : (diagonal ? 'b' : 'r');
+        for (int square = _square + delta; length > 0; length--, square += delta) {
+            char piece = board[square];
+            if (piece != 0) {
+                if (piece == slider || piece == queen) return true;
+                break;
+            }
+        }
+    }
+
+    return false;
+}
+
+bool Position::InCheck() const {
+    int king = FindKing(sideToMove == 'w');
+    return king != NO_SQUARE && IsSquareAttacked(king, sideToMove != 'w');
+}
+
+bool Position::IsLegal(Move16 _move) const {
+    int inCheck = -1;
+    return IsLegal(_move, FindKing(sideToMove == 'w'), inCheck);
+}
+
+bool Position::IsLegal(Move16 _move, int _king, int& _inCheck) const {
+    /*
+     * _move must be pseudo legal, it is legal if the mover's king is not left attacked. When not in check, a piece
+     * other than the king that does not share a line with its king cannot expose it, so most moves skip the replay.
+     * _inCheck is -1 until it is needed, and is then worked out once for every move tried from this position
+     */
+
+    bool white = sideToMove == 'w';
+    int from = MoveFrom(_move);
+    if (_king != NO_SQUARE && from != _king && MoveFlagOf(_move) != EN_PASSANT) {
+        int df = from % 8 - _king % 8, dr = from / 8 - _king / 8;
+        if (df != 0 && dr != 0 && std::abs(df) != std::abs(dr)) {
+            if (_inCheck < 0) _inCheck = IsSquareAttacked(_king, !white) ? 1 : 0;
+            if (_inCheck == 0) return true;
+        }
+    }
+
+    Position after = *this;
+    after.Apply(_move);
+
+    int king = after.FindKing(white);
+    return king != NO_SQUARE && !after.IsSquareAttacked(king, !white);
+}
+
+bool Position::CanReach(int _from, int _to) const {
+    /*
+     * Whether the piece on _from could move to _to ignoring checks. Castling is handled by CastleMove
+     */
+
+    char piece = board[_from];
+    char type = PieceType(piece);
+    bool white = IsWhitePiece(piece);
+    if (piece == 0 || _from == _to || IsOwnPiece(_to, white)) return false;
+
+    int df = _to % 8 - _from % 8, dr = _to / 8 - _from / 8;
+
+    switch (type) {
+        case 'p': {
+            int dir = white ? 1 : -1;
+            int startRank = white ? 1 : 6;
+
+            // captures, including en passant
+            if (std::abs(df) == 1 && dr == dir) return board[_to] != 0 || _to == epSquare;
+
+            // pushes
+            if (df != 0 || board[_to] != 0) return false;
+            if (dr == dir) return true;
+            return dr == 2 * dir && _from / 8 == startRank && board[_from + 8 * dir] == 0;
+        }
+
+        case 'n':
+            return (std::abs(df) == 1 && std::abs(dr) == 2) || (std::abs(df) == 2 && std::abs(dr) == 1);
+
+        case 'k':
+            return std::abs(df) <= 1 && std::abs(dr) <= 1;
+
+        case 'b':
+        case 'r':
+        case 'q': {
+            bool diagonal = std::abs(df) == std::abs(dr);
+            bool straight = df == 0 || dr == 0;
+            if (type == 'b' && !diagonal) return false;
+            if (type == 'r' && !straight) return false;
+            if (!diagonal && !straight) return false;
+
+            // path between the squares must be empty
+            int stepF = (df > 0) - (df < 0), stepR = (dr > 0) - (dr < 0);
+            int square = _from + stepR * 8 + stepF;
+            while (square != _to) {
+                if (board[square] != 0) return false;
+                square += stepR * 8 + stepF;
+            }
+            return true;
+        }
+
+        default:
+            return false;
+    }
+}
+
+Move16 Position::CastleMove(bool _kingside) const {
+    bool white = sideToMove == 'w';
+    uint8_t right = white ? (_kingside ? WHITE_KINGSIDE : WHITE_QUEENSIDE) : (_kingside ? BLACK_KINGSIDE : BLACK_QUEENSIDE);
+    int king = white ? 4 : 60;
+    if (!(castling & right) || board[king] != (white ? 'K' : 'k')) return MOVE_NONE;
+
+    // squares between king and rook are empty, and the king does not pass through check
+    int rook = _kingside ? king + 3 : king - 4;
+    if (board[rook] != (white ? 'R' : 'r')) return MOVE_NONE;
+    for (int square = std::min(king, rook) + 1; square < std::max(king, rook); square++) {
+        if (board[square] != 0) return MOVE_NONE;
+    }
+
+    int dir = _kingside ? 1 : -1;
+    for (int square : {king, king + dir, king + 2 * dir}) {
+        if (IsSquareAttacked(square, !white)) return MOVE_NONE;
+    }
+
+    return EncodeMove(king, king + 2 * dir, CASTLING);
+}
+
+void Position::GenerateLegalMoves(std::vector<Move16>& _moves) const {
+    _moves.clear();
+    bool white = sideToMove == 'w';
+    int king = FindKing(white);
+    int inCheck = -1;
+
+    for (int from = 0; from < 64; from++) {
+        if (!IsOwnPiece(from, white)) continue;
+        bool pawn = PieceType(board[from]) == 'p';
+
+        for (int to = 0; to < 64; to++) {
+            if (!CanReach(from, to)) continue;
+
+            Move16 move;
+            if (pawn && (to / 8 == 0 || to / 8 == 7)) {
+                for (char promo : {'q', 'r', 'b', 'n'}) {
+                    move = EncodeMove(from, to, PROMOTION, promo);
+                    if (IsLegal(move, king, inCheck)) _moves.push_back(move);
+                }
+                continue;
+            }
+
+            move = (pawn && to == epSquare) ? EncodeMove(from, to, EN_PASSANT) : EncodeMove(from, to);
+            if (IsLegal(move, king, inCheck)) _moves.push_back(move);
+        }
+    }
+
+    for (bool kingside : {true, false}) {
+        Move16 move = CastleMove(kingside);
+        if (move != MOVE_NONE) _moves.push_back(move);
+    }
+}
+
+int Position::FindOrigins(int _to, char _pieceType, bool _white, int (&_origins)[8]) const {
+    /*
+     * Squares holding one of the mover's _pieceType pieces that are placed to reach _to: one step back along each
+     * knight or king step, the first piece along each slider ray, or the one or two squares behind for pawns. The
+     * board between them is checked by CanReach
+     */
+
+    int nOrigins = 0;
+    int file = _to % 8, rank = _to / 8;
+    char piece = _white ? char(_pieceType - ('a' - 'A')) : _pieceType;
+
+    auto tryOrigin = [&](int _file, int _rank) {
+        if (OnBoard(_file, _rank) && board[_rank * 8 + _file] == piece) _origins[nOrigins++] = _rank * 8 + _file;
+    };
+
+    switch (_pieceType) {
+        case 'p': {
+            int back = _white ? -1 : 1;
+            tryOrigin(file - 1, rank + back);
+            tryOrigin(file + 1, rank + back);
+            tryOrigin(file, rank + back);
+            if (OnBoard(file, rank + back) && board[(rank + back) * 8 + file] == 0) tryOrigin(file, rank + 2 * back);
+            break;
+        }
+
+        case 'n': {
+            const StepTables& steps = Steps();
+            for (int step = 0; step < steps.knightCount[_to]; step++) {
+                int from = steps.knightTargets[_to][step];
+                if (board[from] == piece) _origins[nOrigins++] = from;
+            }
+            break;
+        }
+
+        case 'k':
+            for (const auto& step : KING_STEPS) tryOrigin(file + step[0], rank + step[1]);
+            break;
+
+        case 'b':
+        case 'r':
+        case 'q':
+            for (const auto& step : KING_STEPS) {
+                bool diagonal = step[0] != 0 && step[1] != 0;
+                if ((_pieceType == 'b' && !diagonal) || (_pieceType == 'r' && diagonal)) continue;
+
+                int f = file + step[0], r = rank + step[1];
+                while (OnBoard(f, r) && board[r * 8 + f] == 0) {
+                    f += step[0];
+                    r += step[1];
+                }
+                tryOrigin(f, r);
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    return nOrigins;
+}
+
+Move16 Position::ParseSAN(const std::string& _san) const {
+    /*
+     * Resolves a SAN move (e.g. Nbd7, exd6, e8=Q+, O-O-O) against the legal moves of the position. Annotation suffixes
+     * are ignored. Returns MOVE_NONE if the move is not legal or is ambiguous
+     */
+
+    std::string san = _san;
+    while (!san.empty() && strchr("+#!?", san.back()) != nullptr) san.pop_back();
+    if (san.length() < 2) return MOVE_NONE;
+
+    if (san == "O-O" || san == "0-0") return CastleMove(true);
+    if (san == "O-O-O" || san == "0-0-0") return CastleMove(false);
+
+    // promotion, with or without '='
+    char promoteTo = 0;
+    if (std::strchr("QRBN", san.back()) != nullptr && san.length() > 2) {
+        size_t rankIndex = san.length() - 2;
+        if (san[rankIndex] == '=') rankIndex--;
+        if (std::isdigit(san[rankIndex])) {
+            promoteTo = (char)std::tolower(san.back());
+            san.erase(rankIndex + 1);
+        }
+    }
+    if (san.length() < 2) return MOVE_NONE;
+
+    // destination is always the last square named
+    char toFile = san[san.length() - 2], toRank = san[san.length() - 1];
+    if (toFile < 'a' || toFile > 'h' || toRank < '1' || toRank > '8') return MOVE_NONE;
+    int to = Square(toFile, toRank - '0');
+
+    // piece letter, then optional disambiguation and capture mark
+    size_t index = 0;
+    char pieceType = 'p';
+    if (std::strchr("NBRQK", san[0]) != nullptr) pieceType = (char)std::tolower(san[index++]);
+
+    int fromFile = -1, fromRank = -1;
+    for (; index < san.length() - 2; index++) {
+        char c = san[index];
+        if (c >= 'a' && c <= 'h') fromFile = c - 'a';
+        else if (c >= '1' && c <= '8') fromRank = c - '1';
+        else if (c != 'x' && c != ':') return MOVE_NONE;
+    }
+
+    bool white = sideToMove == 'w';
+    bool promotionRank = (to / 8 == (white ? 7 : 0));
+    if (pieceType == 'p' && promotionRank != (promoteTo != 0)) return MOVE_NONE;
+    if (pieceType != 'p' && promoteTo != 0) return MOVE_NONE;
+
+    // Origins are found walking back from the destination, so only squares that could hold the piece are tried
+    int candidates[8];
+    int nCandidates = FindOrigins(to, pieceType, white, candidates);
+
+    // whether we are in check is only worked out if a candidate needs it
+    int king = FindKing(white);
+    int inCheck = -1;
+
+    Move16 found = MOVE_NONE;
+    for (int candidate = 0; candidate < nCandidates; candidate++) {
+        int from = candidates[candidate];
+        if (fromFile >= 0 && from % 8 != fromFile) continue;
+        if (fromRank >= 0 && from / 8 != fromRank) continue;
+        if (!CanReach(from, to)) continue;
+
+        Move16 move;
+        if (promoteTo != 0) move = EncodeMove(from, to, PROMOTION, promoteTo);
+        else if (pieceType == 'p' && to == epSquare && from % 8 != to % 8) move = EncodeMove(from, to, EN_PASSANT);
+        else move = EncodeMove(from, to);
+
+        if (!IsLegal(move, king, inCheck)) continue;
+
+        // two legal candidates, the SAN did not disambiguate
+        if (found != MOVE_NONE) return MOVE_NONE;
+        found = move;
+    }
+
+    return found;
+}
+
+std::string Position::ToSAN(Move16 _move) const {
+    int from = MoveFrom(_move), to = MoveTo(_move), flag = MoveFlagOf(_move);
+    char piece = PieceType(board[from]);
+    bool capture = board[to] != 0 || flag == EN_PASSANT;
+    std::string san;
+
+    if (flag == CASTLING) {
+        san = (to > from) ? "O-O" : "O-O-O";
+    } else {
+        if (piece == 'p') {
+            if (capture) san += char('a' + from % 8);
+        } else {
+            san += (char)std::toupper(piece);
+
+            // disambiguate from other pieces of the same type that can legally reach the square, file first
+            bool ambiguous = false, sameFile = false, sameRank = false;
+            for (int other = 0; other < 64; other++) {
+                if (other == from || board[other] != board[from] || !CanReach(other, to)) continue;
+                if (!IsLegal(EncodeMove(other, to))) continue;
+
+                ambiguous = true;
+                if (other % 8 == from % 8) sameFile = true;
+                if (other / 8 == from / 8) sameRank = true;
+            }
+            if (ambiguous && (!sameFile || sameRank)) san += char('a' + from % 8);
+            if (ambiguous && sameFile) san += char('1' + from / 8);
+        }
+
+        if (capture) san += 'x';
+        san += char('a' + to % 8);
+        san += char('1' + to / 8);
+
+        if (flag == PROMOTION) {
+            san += '=';
+            san += (char)std::toupper(MovePromotion(_move));
+        }
+    }
+
+    // check or mate
+    Position after = *this;
+    after.Apply(_move);
+    if (after.InCheck()) {
+        std::vector<Move16> replies;
+        after.GenerateLegalMoves(replies);
+        san += replies.empty() ? '#' : '+';
+    }
+
+    return san;
+}
@@ -46,18 +46,16 @@ bool SelectedPiece::CheckForMoveClicked(const std::unique_ptr<Board>& _board) {
      */
     if (selectedPiece == nullptr) return false;
 
-    auto movesList = *selectedPiece->GetAvailableMovesPtr();
-    if (movesList.empty()) {
-        return false;
-    }
+    // only a press or release can pick a move
+    if (!mouse.IsUnheldActive() && !mouse.IsReleased()) return false;
 
-    for (const auto& move: movesList) {
-        // Fetch the rect bounds of the move and fit to within the 80% dimensions
-        SDL_Rect moveRect;
-        _board->GetBorderedRectFromPosition(moveRect, move.GetPosition());
+    // resolve the square under the mouse directly, then look for a move to it
+    std::pair<char, int> square;
+    if (!_board->GetSquareFromPixel(mouse.GetMousePosition(), square)) return false;
 
-        // test if mouse click is inside the rect
-        if (mouse.ClickOnRelease(moveRect) || mouse.UnheldClick(moveRect)) {
+    auto movesList = *selectedPiece->GetAvailableMovesPtr();
+    for (const auto& move: movesList) {
+        if (move.GetPosition() == square) {
             selectedMove = move;
             return true;
         }
@@ -185,6 +183,28 @@ void SelectedPiece::CreateACNstring(const std::vector<std::unique_ptr<Piece>>& _
     moveList.push_back(lastMoveACN);
 }
 
+std::string SelectedPiece::GetUCIMoveString() const {
+    /*
+     * Returns the last move as a UCI string [position][destination][promotion], e.g. e7e8q. Castling is the kings two
+     * square move.
+     */
+
+    if (lastMovedPiece == nullptr) return {};
+
+    std::string move;
+    move += lastMovedInfo.gamepos.first;
+    move += std::to_string(lastMovedInfo.gamepos.second);
+    move += lastMove.GetPosition().first;
+    move += std::to_string(lastMove.GetPosition().second);
+
+    // promoted pawns are marked as captured
+    if (lastMovedPiece->IsCaptured() && lastMovedPiece->GetPromotedTo() != nullptr) {
+        move += (char)tolower(lastMovedPiece->GetPromotedTo()->GetPieceInfoPtr()->pieceID);
+    }
+
+    return move;
+}
+
 void SelectedPiece::GetACNMoveString(std::string &_move) {
     _move = lastMoveACN;
 }
@@ -17,6 +17,12 @@
 #include "../../src_headers/GlobalResources.h"
 #include "../../src_headers/GlobalSource.h"
 #include "Piece.h"
+#include "CompiledTextureCache.h"
+#include "GameJournal.h"
+#include "GameRecord.h"
+#include "PGN.h"
+#include "GameDatabase.h"
+#include "GameDataManifest.h"
 #include "ResourceManagers.h"
 
 /*
@@ -47,12 +53,27 @@ class Board{
 
         // Local resource manager pointers
         enum RectID : int;
-        GenericManager<SDL_Rect>* rm = new GenericManager<SDL_Rect>;
+        FlatManager<SDL_Rect, 16>* rm = new FlatManager<SDL_Rect, 16>;
+
+        // Compiled board / promotion menu textures, owned by the cache
+        CompiledTextureCache compiledCache {};
+        SDL_Texture* compiledBoard = nullptr;
+        SDL_Texture* compiledPromo[2] {};
+        bool flipped = false;
 
         // Gameplay recording vars
         std::string gameDataDirPath = "../GameData";
+        GameDataManifest gameDataManifest {};
+        std::string gameDirPath;
         std::string moveListFilePath;
         std::string startPosFilePath;
+        GameJournal moveJournal {};
+        std::string recordFilePath;
+        std::string pgnFilePath;
+        GameRecord gameRecord {};
+        std::string gameDatabaseDirPath = "../GameDatabase";
+        GameDatabase gameDatabase {};
+        bool recordInDatabase = false;
         std::string timeFormat = "%d_%m_%Y_%H_%M_%S";
         std::string timeStringFormat = "dd_mm_yyyyThh:mm:ssZ";
         int halfturns = 0;
@@ -60,11 +81,12 @@ class Board{
 
     public:
         Board();
+        ~Board();
 
         int CreateBoardTexture();
         bool CreatePromoMenuTexture();
         void DisplayGameBoard();
-        void DisplayPromoMenu(const std::unique_ptr<Piece>& _promotingPiece);
+        void DisplayPromoMenu(char _colID);
 
         char GetPromoMenuInput();
 
@@ -77,10 +99,18 @@ class Board{
         void GetBoardBLPosition(int& _x, int& _y) const;
         void GetTileRectFromPosition(SDL_Rect& rect, std::pair<char, int> position) const;
         void GetBorderedRectFromPosition(SDL_Rect &_rect, std::pair<char, int> _position) const;
+        bool GetSquareFromPixel(std::pair<int, int> _pixel, std::pair<char, int>& _square) const;
         int GetHalfTurn() const { return halfturns; };
 
         // Setters
         void FillToBounds(int _w, int _h);
+        void UpdateTileLayout();
+        void SetFlipped(bool _flipped) { flipped = _flipped; };
+        void SetTurn(char _sideToMove, int _fullmove) {
+            currentTurn = std::max(_fullmove, 1);
+            halfturns = (currentTurn - 1) * 2 + (_sideToMove == 'b' ? 1 : 0);
+        };
+        [[nodiscard]] bool IsFlipped() const { return flipped; };
         void SetBoardPos(int _x, int _y);
 
         // Gameplay Recording
@@ -90,6 +120,12 @@ class Board{
         bool WriteStartPositionsToFile(const std::vector<std::unique_ptr<Piece>>& _whitePieces,
                                        const std::vector<std::unique_ptr<Piece>>& _blackPieces);
         bool WriteMoveToFile(const std::string& _move);
+        bool FlushGameFiles();
+        void CloseGameFiles();
+        void TickGameFiles() { moveJournal.Tick(); };
+        bool RecordStart(const std::string& _startFEN);
+        bool RecordMove(const std::string& _uciMove);
+        void RecordResult(GameResult _result);
         [[nodiscard]] std::string CreateFEN(const std::vector<std::unique_ptr<Piece>>& _teamPieces,
                                             const std::vector<std::unique_ptr<Piece>>& _oppPieces) const;
         void IncrementTurn();
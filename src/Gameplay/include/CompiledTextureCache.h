@@ -0,0 +1,71 @@
+//
+// Created by cew05 on 19/10/2026.
+//
+
+#ifndef CHESS_WITH_SDL_COMPILEDTEXTURECACHE_H
+#define CHESS_WITH_SDL_COMPILEDTEXTURECACHE_H
+
+#include <list>
+#include <map>
+#include <optional>
+#include <tuple>
+#include <SDL.h>
+
+/*
+ * LRU cache of textures compiled by the Board (the board with its tiles and labels, and the promotion menus). Entries
+ * are keyed by what they were drawn from, so returning to a previous size, style or orientation is a lookup. The cache
+ * owns its textures and destroys the least recently used once over its VRAM budget. The Board draws the entry of each
+ * kind it last fetched or stored straight from its texture, so those are never evicted.
+ */
+
+struct CompiledTextureKey {
+    enum Kind : int {
+        BOARD, PROMO_WHITE, PROMO_BLACK, KIND_COUNT,
+    };
+
+    Kind kind = BOARD;
+    int boardStyle = 0;
+    int pieceStyle = 0;
+    int w = 0, h = 0;
+    bool flipped = false;
+
+    bool operator<(const CompiledTextureKey& _other) const {
+        return std::tie(kind, boardStyle, pieceStyle, w, h, flipped) <
+               std::tie(_other.kind, _other.boardStyle, _other.pieceStyle, _other.w, _other.h, _other.flipped);
+    }
+};
+
+class CompiledTextureCache {
+    private:
+        struct Entry {
+            CompiledTextureKey key;
+            SDL_Texture* texture = nullptr;
+            size_t bytes = 0;
+        };
+
+        // front is the most recently used
+        std::list<Entry> entries {};
+        std::map<CompiledTextureKey, std::list<Entry>::iterator> lookup {};
+
+        size_t usedBytes = 0;
+        size_t maxBytes = 64 * 1024 * 1024;
+
+        // the board and both promotion menus in use, one per kind
+        std::optional<CompiledTextureKey> inUse[CompiledTextureKey::KIND_COUNT] {};
+
+        [[nodiscard]] bool IsInUse(const CompiledTextureKey& _key) const;
+        void Evict();
+
+    public:
+        ~CompiledTextureCache();
+
+        void SetBudget(size_t _maxBytes) { maxBytes = _maxBytes; Evict(); };
+
+        SDL_Texture* Fetch(const CompiledTextureKey& _key);
+        void Store(const CompiledTextureKey& _key, SDL_Texture* _texture);
+        void Clear();
+
+        [[nodiscard]] size_t UsedBytes() const { return usedBytes; };
+};
+
+#endif //CHESS_WITH_SDL_COMPILEDTEXTURECACHE_H
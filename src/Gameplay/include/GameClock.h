@@ -0,0 +1,51 @@
+//
+// Created by cew05 on 19/10/2026.
+//
+
+#ifndef CHESS_WITH_SDL_GAMECLOCK_H
+#define CHESS_WITH_SDL_GAMECLOCK_H
+
+#include <string>
+
+#include "../../src_headers/GlobalSource.h"
+
+/*
+ * Chess clock for both sides. Time is stored in milliseconds and is only charged to the side to move. Remaining time
+ * is measured against SDL_GetTicks64 rather than frame ticks, so time spent blocked waiting on the engine is charged to
+ * the correct side.
+ */
+
+class GameClock {
+    private:
+        // remaining time and increment, index 0 for white, 1 for black
+        Uint64 remaining[2] {};
+        Uint64 increment[2] {};
+        Uint64 baseTime = 0;
+
+        // current turn timing
+        int activeSide = 0;
+        Uint64 turnStartTick = 0;
+        bool running = false;
+
+        static int SideIndex(char _colID) { return (_colID == 'W') ? 0 : 1; }
+
+    public:
+        GameClock(Uint64 _baseMs, Uint64 _incMs);
+
+        // Control
+        void Reset();
+        void Start(char _colID);
+        void Stop();
+        void Press();
+
+        // Getters
+        [[nodiscard]] Uint64 GetRemaining(char _colID) const;
+        [[nodiscard]] Uint64 GetIncrement(char _colID) const;
+        [[nodiscard]] bool HasFlagged(char _colID) const;
+        [[nodiscard]] bool IsRunning() const { return running; };
+        [[nodiscard]] bool IsTimed() const { return baseTime > 0; };
+        [[nodiscard]] std::string GetClockString(char _colID) const;
+};
+
+
+#endif //CHESS_WITH_SDL_GAMECLOCK_H
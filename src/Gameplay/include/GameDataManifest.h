@@ -0,0 +1,77 @@
+//
+// Created by cew05 on 19/10/2026.
+//
+
+#ifndef CHESS_WITH_SDL_GAMEDATAMANIFEST_H
+#define CHESS_WITH_SDL_GAMEDATAMANIFEST_H
+
+#include <string>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+
+/*
+ * Index of the recorded game directories in GameData, oldest first, so retention never has to list the directory or
+ * read dates back out of folder names. Each game is a "<created> <bytes> <name>" line; new games and size changes are
+ * appended, a later line for the same name replacing the earlier one, and the file is rewritten compactly after
+ * directories are removed. Trimming runs on a background thread and only ever looks at the oldest entries, so each
+ * game costs O(1) to retire. Without a manifest one is built once from the directory's modification times.
+ */
+
+struct RetentionPolicy {
+    int maxGames = 10;
+    int maxAgeDays = 0;      // 0 keeps games of any age
+    uint64_t maxBytes = 0;   // 0 keeps games of any total size
+};
+
+class GameDataManifest {
+    private:
+        struct Entry {
+            std::string name;
+            int64_t created;
+            uint64_t bytes;
+        };
+
+        std::string gameDataDir {};
+        std::string manifestPath {};
+        RetentionPolicy policy {};
+
+        std::mutex manifestMutex {};
+        std::deque<Entry> entries {};
+        uint64_t totalBytes = 0;
+
+        // Background trimming
+        std::thread trimThread;
+        std::condition_variable trimWake {};
+        bool trimRequested = false;
+        bool stopping = false;
+
+        bool Load();
+        void Rebuild();
+        bool Rewrite();
+        bool AppendLine(const Entry& _entry);
+        Entry* FindEntry(const std::string& _name);
+        [[nodiscard]] bool ExceedsPolicy(int64_t _now) const;
+
+        void TrimLoop();
+        void Trim();
+
+    public:
+        GameDataManifest() = default;
+        ~GameDataManifest();
+        GameDataManifest(const GameDataManifest&) = delete;
+        GameDataManifest& operator=(const GameDataManifest&) = delete;
+
+        bool Open(const std::string& _gameDataDir, const RetentionPolicy& _policy);
+        void Close();
+        [[nodiscard]] bool IsOpen() const { return trimThread.joinable(); };
+
+        // Games are given by their directory path, adding one also trims the oldest games if over the policy
+        bool AddGame(const std::string& _gameDirPath);
+        void UpdateGameSize(const std::string& _gameDirPath);
+        void RequestTrim();
+};
+
+#endif //CHESS_WITH_SDL_GAMEDATAMANIFEST_H
@@ -0,0 +1,174 @@
+//
+// Created by cew05 on 19/10/2026.
+//
+
+#ifndef CHESS_WITH_SDL_GAMEDATABASE_H
+#define CHESS_WITH_SDL_GAMEDATABASE_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <cstdint>
+
+#include "Position.h"
+#include "GameRecord.h"
+#include "PGN.h"
+#include "../../src_headers/MappedFile.h"
+
+/*
+ * On disk game database answering "which games reached this position". Games are appended to Games.cgd, each one a
+ * header, start FEN, metadata and its Move16 list. Every position of every game is indexed by its Zobrist key in sorted
+ * runs (Positions-<first>-<end>.cpi, covering game ids first to end) that are memory mapped and binary searched. New
+ * games are written as a small run on Commit, and a run is merged into the one before it once it is at least half its
+ * size, so there are only ever a logarithmic number of runs to search. Commit writes the games before their run, so
+ * games left without a run by a crash are indexed again on Open. A database opened read only never writes, cuts off or
+ * removes files, so it can be opened while another instance is adding games.
+ */
+
+struct GameEntryHeader {
+    uint32_t magic;
+    uint32_t length;
+    uint32_t plyCount;
+    uint32_t metaLength;
+    uint16_t fenLength;
+    uint8_t result;
+    uint8_t reserved[5];
+    int64_t startTime;
+};
+static_assert(sizeof(GameEntryHeader) == 32, "GameEntryHeader layout is part of the game database format");
+
+// One position of one game, with the move played from it (MOVE_NONE at the end of the game)
+struct PositionEntry {
+    uint64_t key;
+    uint32_t gameID;
+    Move16 nextMove;
+    uint16_t plyResult;
+
+    [[nodiscard]] int Ply() const { return plyResult >> 2; };
+    [[nodiscard]] GameResult Result() const { return GameResult(plyResult & 3); };
+    bool operator<(const PositionEntry& _other) const {
+        if (key != _other.key) return key < _other.key;
+        if (gameID != _other.gameID) return gameID < _other.gameID;
+        return plyResult < _other.plyResult;
+    };
+};
+static_assert(sizeof(PositionEntry) == 16, "PositionEntry layout is part of the game database format");
+
+struct PositionRunHeader {
+    char magic[4];
+    uint16_t version;
+    uint16_t reserved;
+    uint32_t firstGame;
+    uint32_t endGame;
+    uint64_t entryCount;
+    uint64_t reserved2;
+};
+static_assert(sizeof(PositionRunHeader) == 32, "PositionRunHeader layout is part of the game database format");
+
+struct PositionHit {
+    uint32_t gameID;
+    int ply;
+};
+
+// Games that continued from a position with one move, scored for the side to move
+struct MoveStatistic {
+    Move16 move = Position::MOVE_NONE;
+    uint32_t games = 0;
+    uint32_t wins = 0;
+    uint32_t draws = 0;
+    uint32_t losses = 0;
+
+    [[nodiscard]] float Score() const { return games ? (float(wins) + 0.5f * float(draws)) / float(games) : 0; };
+};
+
+struct StoredGame {
+    std::string startFEN {};
+    std::string metadata {};
+    std::vector<Move16> moves {};
+    GameResult result = GameResult::ONGOING;
+    int64_t startTime = 0;
+};
+
+class GameDatabase {
+    private:
+        static const uint32_t gameMagic = 0x47444743; // "CGDG"
+        static const uint16_t runVersion = 1;
+
+        // plies past this are not indexed, the ply must fit in PositionEntry::plyResult
+        static constexpr int maxIndexedPly = 16383;
+
+        struct PositionRun {
+            std::unique_ptr<MappedFile> file;
+            std::string path;
+            uint32_t firstGame;
+            uint32_t endGame;
+            const PositionEntry* entries;
+            uint64_t entryCount;
+        };
+
+        std::string directory {};
+        std::string gamesPath {};
+        bool open = false;
+        bool readOnly = false;
+
+        // committed games
+        MappedFile gamesFile {};
+        uint64_t gamesEnd = 0;
+        std::vector<uint64_t> gameOffsets {};
+        std::vector<PositionRun> runs {};
+
+        // games added since the last commit
+        std::mutex pendingMutex {};
+        std::string pendingGames {};
+        std::vector<PositionEntry> pendingEntries {};
+        uint32_t pendingCount = 0;
+        size_t maxPendingEntries = 1 << 22;
+
+        bool LoadGames();
+        bool LoadRuns();
+        bool MapRun(PositionRun& _run);
+        [[nodiscard]] std::string RunPath(uint32_t _firstGame, uint32_t _endGame) const;
+        bool WriteRun(const std::string& _path, uint32_t _firstGame, uint32_t _endGame, const PositionEntry* _a,
+                      uint64_t _aCount, const PositionEntry* _b, uint64_t _bCount);
+        bool AddRun(uint32_t _firstGame, uint32_t _endGame, std::vector<PositionEntry>& _entries);
+        bool MergeRuns();
+        bool CommitLocked();
+        bool IndexStoredGames(uint32_t _firstGame);
+        static void RemoveFile(const std::string& _path);
+
+        static void IndexGame(const Position& _start, const std::vector<Move16>& _moves, GameResult _result,
+                              uint32_t _gameID, std::vector<PositionEntry>& _entries);
+        static void RunRange(const PositionRun& _run, uint64_t _key, const PositionEntry*& _begin,
+                             const PositionEntry*& _end);
+
+    public:
+        GameDatabase() = default;
+        ~GameDatabase();
+
+        bool Open(const std::string& _directory, bool _readOnly = false);
+        void Close();
+        [[nodiscard]] bool IsOpen() const { return open; };
+
+        // Adding games, safe to call from several threads. Games are not searchable until Commit, which also runs
+        // on its own whenever enough positions are waiting
+        bool AddGame(const std::string& _startFEN, const std::vector<Move16>& _moves, GameResult _result,
+                     const std::string& _metadata = "", int64_t _startTime = 0);
+        bool AddRecord(const GameRecord& _record);
+        bool AddRecord(const GameRecordReader& _record);
+        bool AddPgnGame(const PgnGame& _game);
+        size_t ImportPgn(const std::string& _path, int _threads = 1);
+        bool Commit();
+
+        // Queries over committed games
+        void FindGames(const Position& _position, std::vector<PositionHit>& _hits, size_t _limit = SIZE_MAX) const;
+        [[nodiscard]] uint64_t CountGames(const Position& _position) const;
+        void FetchMoveStatistics(const Position& _position, std::vector<MoveStatistic>& _statistics) const;
+        bool FetchGame(uint32_t _gameID, StoredGame& _game) const;
+
+        // Getters
+        [[nodiscard]] uint32_t GameCount() const { return (uint32_t)gameOffsets.size(); };
+        [[nodiscard]] size_t RunCount() const { return runs.size(); };
+};
+
+#endif //CHESS_WITH_SDL_GAMEDATABASE_H
@@ -0,0 +1,54 @@
+//
+// Created by cew05 on 19/10/2026.
+//
+
+#ifndef CHESS_WITH_SDL_GAMEJOURNAL_H
+#define CHESS_WITH_SDL_GAMEJOURNAL_H
+
+#include <string>
+#include <cstdio>
+
+#include "../../src_headers/GlobalSource.h"
+
+/*
+ * Append only writer for a game data file. The file is kept open and writes are batched in memory, then flushed every
+ * flushMoves moves, once flushInterval ms have passed since the last flush, or when the game ends. With syncOnFlush set
+ * each flush is also committed to disk, so a crash loses at most the unflushed moves.
+ */
+
+class GameJournal {
+    private:
+        FILE* file = nullptr;
+        std::string path {};
+        std::string buffer {};
+
+        // flush policy
+        int flushMoves = 8;
+        Uint64 flushInterval = 2000;
+        bool syncOnFlush = false;
+
+        int pendingMoves = 0;
+        Uint64 lastFlushTick = 0;
+
+    public:
+        GameJournal() = default;
+        ~GameJournal();
+        GameJournal(const GameJournal&) = delete;
+        GameJournal& operator=(const GameJournal&) = delete;
+
+        void SetFlushPolicy(int _moves, int _intervalMs, bool _sync);
+
+        bool Open(const std::string& _path, bool _truncate);
+        void Close();
+        [[nodiscard]] bool IsOpen() const { return file != nullptr; };
+
+        // Text is only buffered, a move counts towards the flushMoves policy
+        void Append(const std::string& _text);
+        void AppendMove(const std::string& _text);
+        bool Flush();
+
+        // Called every game tick, flushes once flushInterval ms have passed with text buffered
+        void Tick();
+};
+
+#endif //CHESS_WITH_SDL_GAMEJOURNAL_H
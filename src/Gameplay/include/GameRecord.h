@@ -0,0 +1,104 @@
+//
+// Created by cew05 on 19/10/2026.
+//
+
+#ifndef CHESS_WITH_SDL_GAMERECORD_H
+#define CHESS_WITH_SDL_GAMERECORD_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "Position.h"
+#include "../../src_headers/MappedFile.h"
+
+/*
+ * Binary game record. The file holds a fixed header, the start FEN, a metadata block of "key=value" lines, every ply as
+ * a Move16, then a packed position keyframe every keyframeInterval plies (keyframe k is the position after
+ * k * keyframeInterval plies). Any ply is reached by reading its keyframe and replaying fewer than keyframeInterval
+ * moves.
+ */
+
+enum class GameResult : uint8_t {
+    ONGOING, WHITE_WIN, BLACK_WIN, DRAW,
+};
+
+struct GameRecordHeader {
+    char magic[4];
+    uint16_t version;
+    uint16_t keyframeInterval;
+    uint32_t plyCount;
+    uint32_t keyframeCount;
+    uint32_t fenOffset, fenLength;
+    uint32_t metaOffset, metaLength;
+    uint32_t movesOffset;
+    uint32_t keyframesOffset;
+    int64_t startTime;
+    uint8_t result;
+    uint8_t reserved[7];
+};
+static_assert(sizeof(GameRecordHeader) == 56, "GameRecordHeader layout is part of the game record format");
+
+// Builds a record during play and writes it out whole
+class GameRecord {
+    private:
+        static const uint16_t version = 1;
+
+        std::string startFEN {};
+        std::string metadata {};
+        int64_t startTime = 0;
+        GameResult result = GameResult::ONGOING;
+        uint16_t keyframeInterval = 16;
+
+        Position position {};
+        std::vector<Move16> moves {};
+        std::vector<PackedPosition> keyframes {};
+
+    public:
+        GameRecord() = default;
+
+        void SetKeyframeInterval(int _plies);
+        bool Begin(const std::string& _startFEN, int64_t _startTime);
+        void AddMetadata(const std::string& _key, const std::string& _value);
+        bool AddMove(const std::string& _uci);
+        void SetResult(GameResult _result) { result = _result; };
+
+        // Getters
+        [[nodiscard]] int PlyCount() const { return (int)moves.size(); };
+        [[nodiscard]] bool IsEmpty() const { return startFEN.empty(); };
+        [[nodiscard]] const std::string& StartFEN() const { return startFEN; };
+        [[nodiscard]] const std::string& Metadata() const { return metadata; };
+        [[nodiscard]] const std::vector<Move16>& Moves() const { return moves; };
+        [[nodiscard]] GameResult Result() const { return result; };
+        [[nodiscard]] int64_t StartTime() const { return startTime; };
+        bool Save(const std::string& _path) const;
+};
+
+// Reads a saved record through a memory mapped view
+class GameRecordReader {
+    private:
+        MappedFile recordFile {};
+        const GameRecordHeader* header = nullptr;
+
+    public:
+        GameRecordReader() = default;
+
+        bool Open(const std::string& _path);
+        void Close();
+        [[nodiscard]] bool IsOpen() const { return header != nullptr; };
+
+        // Getters
+        [[nodiscard]] int PlyCount() const { return header ? (int)header->plyCount : 0; };
+        [[nodiscard]] GameResult Result() const { return header ? GameResult(header->result) : GameResult::ONGOING; };
+        [[nodiscard]] int64_t StartTime() const { return header ? header->startTime : 0; };
+        [[nodiscard]] int KeyframeInterval() const { return header ? header->keyframeInterval : 0; };
+        [[nodiscard]] std::string StartFEN() const;
+        [[nodiscard]] std::string Metadata() const;
+        [[nodiscard]] Move16 MoveAt(int _ply) const;
+
+        // Position after _ply plies, from the nearest keyframe at or before it
+        bool SeekPly(int _ply, Position& _position) const;
+        bool FetchKeyframe(int _index, Position& _position) const;
+};
+
+#endif //CHESS_WITH_SDL_GAMERECORD_H
@@ -0,0 +1,64 @@
+//
+// Created by cew05 on 19/10/2026.
+//
+
+#ifndef CHESS_WITH_SDL_GAMEREVIEW_H
+#define CHESS_WITH_SDL_GAMEREVIEW_H
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+
+#include "Position.h"
+#include "GameRecord.h"
+#include "GameDatabase.h"
+
+/*
+ * Steps through a finished game without building Piece objects. A packed position is kept every keyframeInterval plies;
+ * single steps apply or take back one move, and a seek further than that starts from the nearest keyframe at or before
+ * the target, so any ply costs at most keyframeInterval moves. Steps back below the keyframe the current run started
+ * from go through its keyframe too, as the moves before it have no undo state.
+ */
+
+class GameReview {
+    private:
+        std::string startFEN {};
+        std::vector<Move16> moves {};
+        GameResult result = GameResult::ONGOING;
+
+        int keyframeInterval = 16;
+        std::vector<PackedPosition> keyframes {};
+
+        // current position, and undo state for the plies after undoBase
+        Position position {};
+        int ply = 0;
+        int undoBase = 0;
+        std::vector<Position::UndoState> undoStates {};
+
+        void LoadKeyframe(int _index);
+
+    public:
+        GameReview() = default;
+
+        void SetKeyframeInterval(int _plies) { keyframeInterval = std::max(_plies, 1); };
+        bool Load(const std::string& _startFEN, const std::vector<Move16>& _moves, GameResult _result);
+        bool Load(const GameRecordReader& _record);
+        bool Load(const StoredGame& _game);
+        void Clear();
+
+        // Navigation, each returns false if the ply did not change
+        bool StepForward();
+        bool StepBack();
+        bool SeekPly(int _ply);
+
+        // Getters
+        [[nodiscard]] bool IsLoaded() const { return !startFEN.empty(); };
+        [[nodiscard]] int Ply() const { return ply; };
+        [[nodiscard]] int PlyCount() const { return (int)moves.size(); };
+        [[nodiscard]] GameResult Result() const { return result; };
+        [[nodiscard]] const Position& CurrentPosition() const { return position; };
+        [[nodiscard]] Move16 LastMove() const { return ply > 0 ? moves[ply - 1] : Position::MOVE_NONE; };
+};
+
+#endif //CHESS_WITH_SDL_GAMEREVIEW_H
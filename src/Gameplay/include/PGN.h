@@ -0,0 +1,75 @@
+//
+// Created by cew05 on 19/10/2026.
+//
+
+#ifndef CHESS_WITH_SDL_PGN_H
+#define CHESS_WITH_SDL_PGN_H
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <atomic>
+
+#include "Position.h"
+#include "GameRecord.h"
+#include "../../src_headers/MappedFile.h"
+
+/*
+ * Streaming PGN import / export. The reader tokenises games straight from a memory mapped file: tags are kept, comments,
+ * NAGs and variations are skipped, and the main line SAN is validated and replayed with Position. Large files are split
+ * at game boundaries ("[Event" at the start of a line) and the parts are parsed on separate threads.
+ */
+
+inline const std::string STANDARD_START_FEN = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+struct PgnGame {
+    std::vector<std::pair<std::string, std::string>> tags {};
+    std::string startFEN = STANDARD_START_FEN;
+    std::vector<Move16> moves {};
+    GameResult result = GameResult::ONGOING;
+
+    [[nodiscard]] std::string FetchTag(const std::string& _name) const;
+    void Clear();
+};
+
+class PgnReader {
+    private:
+        MappedFile pgnFile {};
+        std::atomic<size_t> gamesRead {0};
+        std::atomic<size_t> gamesRejected {0};
+
+        size_t ReadRange(const char* _begin, const char* _end, const std::function<void(const PgnGame&)>& _onGame);
+
+    public:
+        PgnReader() = default;
+
+        bool Open(const std::string& _path);
+        void Close();
+
+        // Calls _onGame for every valid game. With more than one thread _onGame is called concurrently, and games are
+        // not delivered in file order. Returns the number of valid games
+        size_t ReadAll(const std::function<void(const PgnGame&)>& _onGame, int _threads = 1);
+
+        // Parses one game starting at _cursor, which is left after the game. Returns false if the game's moves are
+        // invalid, _cursor still moves past it
+        static bool ParseGame(const char*& _cursor, const char* _end, PgnGame& _game);
+
+        [[nodiscard]] size_t GamesRead() const { return gamesRead; };
+        [[nodiscard]] size_t GamesRejected() const { return gamesRejected; };
+};
+
+class PgnWriter {
+    private:
+        static void AddRecordTags(PgnGame& _game, int64_t _startTime, const std::string& _metadata);
+
+    public:
+        static std::string ResultString(GameResult _result);
+        static std::string FormatGame(const PgnGame& _game);
+        static bool WriteGame(const PgnGame& _game, const std::string& _path, bool _append);
+
+        // Game records, the record's metadata lines become tags
+        static PgnGame FromRecord(const GameRecord& _record);
+        static PgnGame FromRecord(const GameRecordReader& _record);
+};
+
+#endif //CHESS_WITH_SDL_PGN_H
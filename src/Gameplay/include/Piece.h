@@ -13,6 +13,7 @@
 
 #include "../../src_headers/GlobalSource.h"
 #include "../../src_headers/GlobalResources.h"
+#include "../../src_headers/SpriteBatch.h"
 #include "Board.h"
 
 /*
@@ -35,6 +36,28 @@ struct PieceInfo {
     TextureID textureID = WHITE_PAWN;
 };
 
+// Copy of a piece's display state, drawn by the render thread without touching the piece itself
+struct PieceSnapshot {
+    TextureID textureID = WHITE_PAWN;
+    std::pair<char, int> gamepos {};
+    std::pair<char, int> lastpos {};
+    bool selected = false;
+    bool heldClick = false;
+    bool showLastMove = false;
+    Uint64 animStartTick = 0;
+    int animLenTicks = 0;
+};
+
+// Marker for one of the selected piece's moves
+struct MoveHint {
+    std::pair<char, int> square {};
+    int atlasCell = 0;
+
+    bool operator==(const MoveHint& _other) const {
+        return square == _other.square && atlasCell == _other.atlasCell;
+    }
+};
+
 class AvailableMove{
     private:
         std::pair<char, int> position {};
@@ -70,7 +93,7 @@ class Piece {
 
         // Local ResourceManager pointers
         enum RectID : int;
-        GenericManager<SDL_Rect>* rm = new GenericManager<SDL_Rect>;
+        FlatManager<SDL_Rect, 2>* rm = new FlatManager<SDL_Rect, 2>;
 
         // SDL display
         std::string imgPath {};
@@ -106,6 +129,16 @@ class Piece {
 
         // Setup
         void SetPos(std::pair<char, int> _position);
+        void SetMoved(bool _hasMoved) { hasMoved = _hasMoved; };
+        void SetCastlingRights(bool _queenside, bool _kingside) {
+            canCastleQueenside = _queenside;
+            canCastleKingside = _kingside;
+        };
+        // Marks a pawn as having just moved two squares, capturable en passant until the end of the next turn
+        void SetPassant() {
+            canPassant = true;
+            passantTimer = 1;
+        };
 
         /*
          * DISPLAY
@@ -113,12 +146,15 @@ class Piece {
 
         // Creating textures
         int CreateTextures();
+        static TextureID TextureIDOf(char _pieceID, char _colID);
         void SetRects(const std::unique_ptr<Board>& _board);
         void GetRectOfBoardPosition(const std::unique_ptr<Board>& _board);
 
-        // Displaying piece / moves
-        void DisplayPiece(const std::unique_ptr<Board>& _board);
-        void DisplayMoves(const std::unique_ptr<Board>& _board);
+        // Snapshots of the piece and its move hints, displayed from a batch drawn from PIECE_ATLAS
+        void FillSnapshot(PieceSnapshot& _snapshot) const;
+        void FetchMoveHints(std::vector<MoveHint>& _hints) const;
+        static void DisplaySnapshot(const PieceSnapshot& _snapshot, const std::unique_ptr<Board>& _board,
+                                    SpriteBatch& _batch);
 
         /*
          * Fetching and testing Moves
@@ -180,7 +216,7 @@ class Piece {
          */
 
         // Selecting Piece
-        void UpdateClickedStatus(const std::vector<std::unique_ptr<Piece>> &_teamPieces);
+        void UpdateClickedStatus(bool _otherClicked, bool _mouseOnSquare);
         void SetSelected(bool _selected);
         void UnselectPiece();
 
@@ -0,0 +1,119 @@
+//
+// Created by cew05 on 19/10/2026.
+//
+
+#ifndef CHESS_WITH_SDL_POSITION_H
+#define CHESS_WITH_SDL_POSITION_H
+
+#include <array>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+/*
+ * Compact chess position used for stored games, independent of the Piece objects used during play. Squares are indexed
+ * a1 = 0 .. h8 = 63 and hold the FEN letter of their piece, or 0 when empty. Moves are 16 bit: the destination square
+ * in bits 0-5, the origin in bits 6-11, the promotion piece in bits 12-13 and a special move flag in bits 14-15.
+ * The rules are only what is needed to validate and name moves of stored games; the Piece classes still run play.
+ */
+
+using Move16 = uint16_t;
+
+// Fixed size position stored in game records, two squares per byte
+struct PackedPosition {
+    uint8_t squares[32];
+    uint8_t sideToMove;
+    uint8_t castling;
+    uint8_t epSquare;
+    uint8_t halfmoveClock;
+    uint16_t fullmove;
+    uint16_t reserved;
+};
+static_assert(sizeof(PackedPosition) == 40, "PackedPosition layout is part of the game record format");
+
+class Position {
+    public:
+        // What Apply cannot recover from the board when taking a move back
+        struct UndoState {
+            char captured;
+            uint8_t castling;
+            int epSquare;
+            int halfmoveClock;
+        };
+
+        enum MoveFlag : int {
+            NORMAL, PROMOTION, EN_PASSANT, CASTLING,
+        };
+        enum CastlingRight : uint8_t {
+            WHITE_KINGSIDE = 1, WHITE_QUEENSIDE = 2, BLACK_KINGSIDE = 4, BLACK_QUEENSIDE = 8,
+        };
+        static const Move16 MOVE_NONE = 0;
+        static const int NO_SQUARE = 64;
+
+    private:
+        std::array<char, 64> board {};
+        char sideToMove = 'w';
+        uint8_t castling = 0;
+        int epSquare = NO_SQUARE;
+        int halfmoveClock = 0;
+        int fullmove = 1;
+
+        // king squares, white then black, kept up to date so legality checks need not search for them
+        int kings[2] = {NO_SQUARE, NO_SQUARE};
+
+        [[nodiscard]] bool IsLegal(Move16 _move, int _king, int& _inCheck) const;
+        void FindKings();
+        [[nodiscard]] bool IsOwnPiece(int _square, bool _white) const;
+        [[nodiscard]] bool CanReach(int _from, int _to) const;
+        [[nodiscard]] Move16 CastleMove(bool _kingside) const;
+        [[nodiscard]] int FindKing(bool _white) const;
+        [[nodiscard]] int FindOrigins(int _to, char _pieceType, bool _white, int (&_origins)[8]) const;
+
+    public:
+        Position() = default;
+
+        // FEN
+        bool FromFEN(const std::string& _fen);
+        [[nodiscard]] std::string ToFEN() const;
+        static std::string FENState(char _sideToMove, uint8_t _castling, int _epSquare, int _halfmoveClock, int _fullmove);
+
+        // Moves
+        static Move16 EncodeMove(int _from, int _to, int _flag = NORMAL, char _promoteTo = 'q');
+        static int MoveFrom(Move16 _move) { return (_move >> 6) & 63; };
+        static int MoveTo(Move16 _move) { return _move & 63; };
+        static int MoveFlagOf(Move16 _move) { return (_move >> 14) & 3; };
+        static char MovePromotion(Move16 _move) { return "nbrq"[(_move >> 12) & 3]; };
+
+        [[nodiscard]] Move16 ParseUCI(const std::string& _uci) const;
+        [[nodiscard]] static std::string ToUCI(Move16 _move);
+        void Apply(Move16 _move);
+        void Apply(Move16 _move, UndoState& _undo);
+        void Undo(Move16 _move, const UndoState& _undo);
+
+        // Rules
+        [[nodiscard]] bool IsSquareAttacked(int _square, bool _byWhite) const;
+        [[nodiscard]] bool InCheck() const;
+        [[nodiscard]] bool IsLegal(Move16 _move) const;
+        void GenerateLegalMoves(std::vector<Move16>& _moves) const;
+
+        // SAN, parsing only accepts legal moves
+        [[nodiscard]] Move16 ParseSAN(const std::string& _san) const;
+        [[nodiscard]] std::string ToSAN(Move16 _move) const;
+
+        // Storage
+        void Pack(PackedPosition& _packed) const;
+        void Unpack(const PackedPosition& _packed);
+
+        // Zobrist key of the placement, castling rights, capturable en passant file and side to move
+        [[nodiscard]] uint64_t Key() const;
+
+        // Getters
+        static int Square(char _file, int _rank) { return (_rank - 1) * 8 + (_file - 'a'); };
+        [[nodiscard]] char PieceOn(int _square) const { return board[_square]; };
+        [[nodiscard]] char SideToMove() const { return sideToMove; };
+        [[nodiscard]] uint8_t Castling() const { return castling; };
+        [[nodiscard]] int EpSquare() const { return epSquare; };
+        [[nodiscard]] int FullMove() const { return fullmove; };
+};
+
+#endif //CHESS_WITH_SDL_POSITION_H
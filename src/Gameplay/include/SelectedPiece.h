@@ -37,6 +37,9 @@ class SelectedPiece {
         std::string GetACNMoveString() { return lastMoveACN; };
         void CreateACNstring(const std::vector<std::unique_ptr<Piece>>& _teamptr);
 
+        // UCI composing
+        [[nodiscard]] std::string GetUCIMoveString() const;
+
         // Making a move
         void MakeMove(const std::unique_ptr<Board>& _board);
         void MakeMove(Piece* _piece,
@@ -9,18 +9,26 @@
  */
 
 bool InitFonts() {
-    // Temp vars
+    // Create font cache
+    fontCache = new FontCache;
 
     /*
      * Construct fonts
      */
 
-    return true;
+    // Rasterise the UI font once, all labels are drawn from its glyph atlas
+    return fontCache->CreateGlyphAtlas(UI_FONT_PATH, UI_FONT_SIZE);
 }
 
 bool InitTextures() {
-    // Create texture Manager
+    /*
+     * Registers the shared textures and finds the installed styles. Style textures are only registered and decoded
+     * when that style is first selected, see LoadBoardStyle / LoadPieceStyle.
+     */
+
+    // Create texture Manager and decode workers
     tm = new TextureManager(window.renderer);
+    textureLoader = new TextureLoader();
 
     // Temp vars
     std::string dirPath;
@@ -30,30 +38,19 @@ bool InitTextures() {
      * Construct Board Textures
      */
 
-    // Produce texture info for all .png files in Resources/GameBoard directory
+    // Find board styles in Resources/GameBoard directory
     dirPath = "../Resources/GameBoard";
     dirCount = 0;
     for (const auto& board : std::filesystem::directory_iterator(dirPath)) {
         // Ignore non-directory entries
         if (!board.is_directory()) continue;
+        if (dirCount >= BOARD_STYLES_MAX) break;
 
-        // Create new style info
-        BOARD_STYLES[dirCount] = {board.path().filename().string(), (TextureID)dirCount};
-
-        // Create the styled Board Textures
-        tm->NewTexture(board.path().string() + "/Board_Base.png", TextureID(BOARD_BASE + BOARD_STYLE.second));
-        tm->NewTexture(board.path().string() + "/Secondary_Base.png", TextureID(BOARD_BASE_SECONDARY + BOARD_STYLE.second));
-        tm->NewTexture(board.path().string() + "/White_Tile.png", TextureID(WHITE_TILE + BOARD_STYLE.second));
-        tm->NewTexture(board.path().string() + "/Black_Tile.png", TextureID(BLACK_TILE + BOARD_STYLE.second));
-        tm->NewTexture(board.path().string() + "/Promotion_Menu.png", TextureID(PROMO_BASE + BOARD_STYLE.second));
-
+        // Create new style info, each style has its own block of texture ids
+        BOARD_STYLES[dirCount] = {board.path().filename().string(), TextureID(dirCount * NUM_BOARD_TEXTURES)};
         dirCount++;
     }
-
-    // Create additional board textures
-    tm->NewTexture(nullptr, BOARD_COMPILED);
-    tm->NewTexture(nullptr, PROMO_BLACK_COMPILED);
-    tm->NewTexture(nullptr, PROMO_WHITE_COMPILED);
+    BOARD_STYLE_COUNT = dirCount;
 
     // Set to default board texture style
     BOARD_STYLE = BOARD_STYLES[0];
@@ -77,32 +74,19 @@ bool InitTextures() {
      * Construct Pieces Textures
      */
 
-    // Produce texture info for all .png files in Resources/Pieces
+    // Find piece styles in Resources/Pieces
     dirPath = "../Resources/Pieces";
     dirCount = 0;
     for (const auto& piece : std::filesystem::directory_iterator(dirPath)) {
         if (!piece.is_directory()) continue;
         if (piece.path().filename() == "Piece") continue;
+        if (dirCount >= PIECE_STYLES_MAX) break;
 
-        // Create style info
-        PIECE_STYLES[dirCount] = {piece.path().filename().string(), (TextureID)dirCount};
-
-        // Create styled piece textures
-        tm->NewTexture(piece.path().string() + "/King/King_White.png", TextureID(WHITE_KING + PIECE_STYLE.second));
-        tm->NewTexture(piece.path().string() + "/King/King_Black.png", TextureID(BLACK_KING + PIECE_STYLE.second));
-        tm->NewTexture(piece.path().string() + "/Queen/Queen_White.png", TextureID(WHITE_QUEEN + PIECE_STYLE.second));
-        tm->NewTexture(piece.path().string() + "/Queen/Queen_Black.png", TextureID(BLACK_QUEEN + PIECE_STYLE.second));
-        tm->NewTexture(piece.path().string() + "/Rook/Rook_White.png", TextureID(WHITE_ROOK + PIECE_STYLE.second));
-        tm->NewTexture(piece.path().string() + "/Rook/Rook_Black.png", TextureID(BLACK_ROOK + PIECE_STYLE.second));
-        tm->NewTexture(piece.path().string() + "/Bishop/Bishop_White.png", TextureID(WHITE_BISHOP + PIECE_STYLE.second));
-        tm->NewTexture(piece.path().string() + "/Bishop/Bishop_Black.png", TextureID(BLACK_BISHOP + PIECE_STYLE.second));
-        tm->NewTexture(piece.path().string() + "/Knight/Knight_White.png", TextureID(WHITE_KNIGHT + PIECE_STYLE.second));
-        tm->NewTexture(piece.path().string() + "/Knight/Knight_Black.png", TextureID(BLACK_KNIGHT + PIECE_STYLE.second));
-        tm->NewTexture(piece.path().string() + "/Pawn/Pawn_White.png", TextureID(WHITE_PAWN + PIECE_STYLE.second));
-        tm->NewTexture(piece.path().string() + "/Pawn/Pawn_Black.png", TextureID(BLACK_PAWN + PIECE_STYLE.second));
-
+        // Create style info, each style has its own block of texture ids
+        PIECE_STYLES[dirCount] = {piece.path().filename().string(), TextureID(dirCount * NUM_PIECE_TEXTURES)};
         dirCount++;
     }
+    PIECE_STYLE_COUNT = dirCount;
 
     // Additional Piece textures
     tm->NewTexture(dirPath + "/Piece/Attacking_Piece.png", CAPTURE);
@@ -112,9 +96,130 @@ bool InitTextures() {
     // Set to default piece style
     PIECE_STYLE = PIECE_STYLES[0];
 
+    // Atlas is built by SetStyles once the style is known
+    tm->NewTexture(nullptr, PIECE_ATLAS);
+
     return true;
 }
 
+bool LoadBoardStyle(int _style) {
+    /*
+     * Registers the textures of a board style and queues their decode. Textures keep their path, so an early
+     * OpenTexture still falls back to loading from disk.
+     */
+
+    if (_style < 0 || _style >= BOARD_STYLE_COUNT) return false;
+    if (BOARD_STYLE_LOADED[_style]) return true;
+
+    std::string path = "../Resources/GameBoard/" + BOARD_STYLES[_style].first;
+    int offset = BOARD_STYLES[_style].second;
+    std::pair<std::string, TextureID> files[NUM_BOARD_TEXTURES] = {
+            {"/Board_Base.png", BOARD_BASE}, {"/Secondary_Base.png", BOARD_BASE_SECONDARY},
+            {"/White_Tile.png", WHITE_TILE}, {"/Black_Tile.png", BLACK_TILE}, {"/Promotion_Menu.png", PROMO_BASE},
+    };
+
+    for (const auto& file : files) {
+        tm->NewTexture(path + file.first, TextureID(file.second + offset));
+        textureLoader->Queue(path + file.first, file.second + offset);
+    }
+
+    BOARD_STYLE_LOADED[_style] = true;
+    return true;
+}
+
+bool LoadPieceStyle(int _style) {
+    if (_style < 0 || _style >= PIECE_STYLE_COUNT) return false;
+    if (PIECE_STYLE_LOADED[_style]) return true;
+
+    std::string path = "../Resources/Pieces/" + PIECE_STYLES[_style].first;
+    int offset = PIECE_STYLES[_style].second;
+
+    // Files are named <Piece>/<Piece>_<Colour>.png, in TextureID order
+    std::string names[NUM_PIECE_TEXTURES / 2] = {"King", "Queen", "Rook", "Bishop", "Knight", "Pawn"};
+    for (int t = 0; t < NUM_PIECE_TEXTURES; t++) {
+        std::string file = path + "/" + names[t / 2] + "/" + names[t / 2] + (t % 2 == 0 ? "_White.png" : "_Black.png");
+        tm->NewTexture(file, TextureID(WHITE_KING + offset + t));
+        textureLoader->Queue(file, WHITE_KING + offset + t);
+    }
+
+    PIECE_STYLE_LOADED[_style] = true;
+    return true;
+}
+
+bool CreatePieceAtlas() {
+    /*
+     * Packs the current piece style, the move / capture / selected markers and a solid white cell into PIECE_ATLAS, so
+     * the board's pieces and overlays can be drawn in a single batch.
+     */
+
+    int atlasSize = ATLAS_CELL_SIZE * ATLAS_GRID;
+    SDL_Texture* atlas = SDL_CreateTexture(window.renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET,
+                                           atlasSize, atlasSize);
+    if (atlas == nullptr) {
+        LogError("Failed to create piece atlas", SDL_GetError(), false);
+        return false;
+    }
+
+    if (SDL_SetRenderTarget(window.renderer, atlas) != 0) {
+        LogError("Failed to set render target", SDL_GetError(), false);
+        return false;
+    }
+
+    // Clear to transparent, copy sprites without blending so their alpha is kept
+    SDL_SetTextureBlendMode(atlas, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawBlendMode(window.renderer, SDL_BLENDMODE_NONE);
+    SDL_SetRenderDrawColor(window.renderer, 0, 0, 0, 0);
+    SDL_RenderClear(window.renderer);
+
+    std::pair<int, TextureID> cells[] = {
+            {ATLAS_MOVE, MOVE}, {ATLAS_CAPTURE, CAPTURE}, {ATLAS_SELECTED, SELECTED},
+    };
+
+    for (int c = ATLAS_PIECES; c < ATLAS_SOLID; c++) {
+        TextureID textureID = (c < ATLAS_MOVE) ? TextureID(WHITE_KING + PIECE_STYLE.second + c) : cells[c - ATLAS_MOVE].second;
+
+        tm->OpenTexture(textureID);
+        SDL_Texture* texture = tm->AccessTexture(textureID);
+        if (texture == nullptr) {
+            LogError("Missing texture for piece atlas", std::to_string(textureID).c_str(), false);
+            continue;
+        }
+
+        SDL_Rect cellRect = GetAtlasRect(c);
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_NONE);
+        SDL_RenderCopy(window.renderer, texture, nullptr, &cellRect);
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+        tm->CloseTexture(textureID);
+    }
+
+    // Solid cell, tinted by vertex colour for highlights
+    SDL_Rect solidRect = GetAtlasRect(ATLAS_SOLID);
+    SDL_SetRenderDrawColor(window.renderer, 255, 255, 255, 255);
+    SDL_RenderFillRect(window.renderer, &solidRect);
+
+    // Reset renderer
+    SDL_SetRenderDrawColor(window.renderer, 0, 0, 0, 0);
+    SDL_SetRenderDrawBlendMode(window.renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderTarget(window.renderer, nullptr);
+
+    tm->UpdateTexture(atlas, PIECE_ATLAS);
+    tm->OpenTexture(PIECE_ATLAS);
+    PIECE_ATLAS_VERSION++;
+    return true;
+}
+
+SDL_Rect GetAtlasRect(int _cell) {
+    // Cell rects are inset by ATLAS_PADDING so filtering does not bleed in neighbouring sprites
+    return {(_cell % ATLAS_GRID) * ATLAS_CELL_SIZE + ATLAS_PADDING,
+            (_cell / ATLAS_GRID) * ATLAS_CELL_SIZE + ATLAS_PADDING,
+            ATLAS_CELL_SIZE - 2*ATLAS_PADDING,
+            ATLAS_CELL_SIZE - 2*ATLAS_PADDING};
+}
+
+int GetPieceAtlasCell(TextureID _textureID) {
+    return _textureID - WHITE_KING - PIECE_STYLE.second;
+}
+
 /*
  * CONFIG FILES
  */
@@ -156,6 +261,38 @@ bool ConfigExists() {
     return true;
 };
 
+std::string FetchConfigValue(const std::string& _key, const std::string& _default) {
+    /*
+     * Reads the value of a "Key=Value" line from the ConfigInfo file. Returns _default when the file or key is not
+     * found.
+     */
+
+    std::ifstream configFile("../RequiredFiles/ConfigInfo");
+    std::string line;
+
+    while (std::getline(configFile, line)) {
+        uint64_t splitpos = line.find('=');
+        if (splitpos == std::string::npos) continue;
+
+        if (line.substr(0, splitpos) == _key) {
+            return line.substr(splitpos + 1, std::string::npos);
+        }
+    }
+
+    return _default;
+}
+
+int FetchConfigValue(const std::string& _key, int _default) {
+    std::string value = FetchConfigValue(_key, std::to_string(_default));
+
+    try {
+        return std::stoi(value);
+    } catch (const std::exception& e) {
+        LogError("Invalid config value for " + _key, value.c_str(), false);
+        return _default;
+    }
+}
+
 bool PieceLayoutsExists() {
     /*
      * Ensures that the piece layouts (standard games + base variations) exist. If not, then they are created.
@@ -165,9 +302,17 @@ bool PieceLayoutsExists() {
     return true;
 }
 
-bool SetStyles() {
-    BOARD_STYLE = BOARD_STYLES[0];
-    PIECE_STYLE = PIECE_STYLES[0];
+bool SetStyles(int _boardStyle, int _pieceStyle) {
+    // Load the selected styles on first use, decoding in parallel
+    if (!LoadBoardStyle(_boardStyle) || !LoadPieceStyle(_pieceStyle)) {
+        LogError("Style not installed", (std::to_string(_boardStyle) + ", " + std::to_string(_pieceStyle)).c_str(), false);
+        return false;
+    }
+    textureLoader->Finish(tm);
 
-    return true;
+    BOARD_STYLE = BOARD_STYLES[_boardStyle];
+    PIECE_STYLE = PIECE_STYLES[_pieceStyle];
+
+    // Pieces are drawn from the atlas of the current style
+    return CreatePieceAtlas();
 }
\ No newline at end of file
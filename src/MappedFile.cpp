@@ -0,0 +1,203 @@
+//
+// Created by cew05 on 19/10/2026.
+//
+
+#include "src_headers/MappedFile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+MappedFile::~MappedFile() {
+    Close();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::OpenRead(const std::string& _path) {
+    Close();
+
+    HANDLE handle = CreateFileA(_path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING,
+                                FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) {
+        printf("Failed to open %s for mapping: %lu\n", _path.c_str(), GetLastError());
+        return false;
+    }
+    file = (intptr_t)handle;
+
+    // empty files cannot be mapped
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(handle, &fileSize) || fileSize.QuadPart == 0) {
+        printf("Cannot map empty file %s\n", _path.c_str());
+        Close();
+        return false;
+    }
+    size = fileSize.QuadPart;
+
+    mapping = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        printf("Failed to create mapping of %s: %lu\n", _path.c_str(), GetLastError());
+        Close();
+        return false;
+    }
+
+    view = (unsigned char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr) {
+        printf("Failed to map view of %s: %lu\n", _path.c_str(), GetLastError());
+        Close();
+        return false;
+    }
+
+    writable = false;
+    return true;
+}
+
+bool MappedFile::OpenReadWrite(const std::string& _path, uint64_t _size) {
+    Close();
+
+    HANDLE handle = CreateFileA(_path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                                nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) {
+        printf("Failed to open %s for mapping: %lu\n", _path.c_str(), GetLastError());
+        return false;
+    }
+    file = (intptr_t)handle;
+
+    // Mapping with a size larger than the file extends the file, new bytes are zeroed
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(handle, &fileSize)) {
+        Close();
+        return false;
+    }
+    size = std::max((uint64_t)fileSize.QuadPart, _size);
+    if (size == 0) {
+        Close();
+        return false;
+    }
+
+    mapping = CreateFileMappingA(handle, nullptr, PAGE_READWRITE, DWORD(size >> 32), DWORD(size & 0xFFFFFFFF), nullptr);
+    if (mapping == nullptr) {
+        printf("Failed to create mapping of %s: %lu\n", _path.c_str(), GetLastError());
+        Close();
+        return false;
+    }
+
+    view = (unsigned char*)MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+    if (view == nullptr) {
+        printf("Failed to map view of %s: %lu\n", _path.c_str(), GetLastError());
+        Close();
+        return false;
+    }
+
+    writable = true;
+    return true;
+}
+
+bool MappedFile::Flush() {
+    if (view == nullptr || !writable) return false;
+
+    return FlushViewOfFile(view, 0) && FlushFileBuffers((HANDLE)file);
+}
+
+void MappedFile::Close() {
+    if (view != nullptr) UnmapViewOfFile(view);
+    if (mapping != nullptr) CloseHandle(mapping);
+    if ((HANDLE)file != INVALID_HANDLE_VALUE) CloseHandle((HANDLE)file);
+
+    view = nullptr;
+    mapping = nullptr;
+    file = -1;
+    size = 0;
+    writable = false;
+}
+
+#else
+
+bool MappedFile::OpenRead(const std::string& _path) {
+    Close();
+
+    file = open(_path.c_str(), O_RDONLY);
+    if (file < 0) {
+        printf("Failed to open %s for mapping: %s\n", _path.c_str(), strerror(errno));
+        return false;
+    }
+
+    // empty files cannot be mapped
+    struct stat fileStat {};
+    if (fstat((int)file, &fileStat) != 0 || fileStat.st_size == 0) {
+        printf("Cannot map empty file %s\n", _path.c_str());
+        Close();
+        return false;
+    }
+    size = (uint64_t)fileStat.st_size;
+
+    void* mapped = mmap(nullptr, size, PROT_READ, MAP_SHARED, (int)file, 0);
+    if (mapped == MAP_FAILED) {
+        printf("Failed to map view of %s: %s\n", _path.c_str(), strerror(errno));
+        Close();
+        return false;
+    }
+    view = (unsigned char*)mapped;
+
+    writable = false;
+    return true;
+}
+
+bool MappedFile::OpenReadWrite(const std::string& _path, uint64_t _size) {
+    Close();
+
+    file = open(_path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (file < 0) {
+        printf("Failed to open %s for mapping: %s\n", _path.c_str(), strerror(errno));
+        return false;
+    }
+
+    // Extend the file to the mapped size first, new bytes are zeroed
+    struct stat fileStat {};
+    if (fstat((int)file, &fileStat) != 0) {
+        Close();
+        return false;
+    }
+    size = std::max((uint64_t)fileStat.st_size, _size);
+    if (size == 0 || (size > (uint64_t)fileStat.st_size && ftruncate((int)file, (off_t)size) != 0)) {
+        Close();
+        return false;
+    }
+
+    void* mapped = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, (int)file, 0);
+    if (mapped == MAP_FAILED) {
+        printf("Failed to map view of %s: %s\n", _path.c_str(), strerror(errno));
+        Close();
+        return false;
+    }
+    view = (unsigned char*)mapped;
+
+    writable = true;
+    return true;
+}
+
+bool MappedFile::Flush() {
+    if (view == nullptr || !writable) return false;
+
+    return msync(view, size, MS_SYNC) == 0 && fsync((int)file) == 0;
+}
+
+void MappedFile::Close() {
+    if (view != nullptr) munmap(view, size);
+    if (file >= 0) close((int)file);
+
+    view = nullptr;
+    mapping = nullptr;
+    file = -1;
+    size = 0;
+    writable = false;
+}
+
+#endif
@@ -0,0 +1,60 @@
+//
+// Created by cew05 on 19/10/2026.
+//
+
+#include "src_headers/SpriteBatch.h"
+#include "src_headers/GlobalSource.h"
+
+void SpriteBatch::Begin(SDL_Texture* _texture) {
+    texture = _texture;
+    vertices.clear();
+    indices.clear();
+
+    if (texture == nullptr || SDL_QueryTexture(texture, nullptr, nullptr, &textureW, &textureH) != 0) {
+        textureW = 1;
+        textureH = 1;
+    }
+}
+
+void SpriteBatch::Add(const SDL_Rect& _srcRect, const SDL_Rect& _destRect, SDL_Color _colour) {
+    // texture coords are normalised to the size of the texture
+    float u0 = (float)_srcRect.x / (float)textureW, v0 = (float)_srcRect.y / (float)textureH;
+    float u1 = (float)(_srcRect.x + _srcRect.w) / (float)textureW, v1 = (float)(_srcRect.y + _srcRect.h) / (float)textureH;
+
+    float x0 = (float)_destRect.x, y0 = (float)_destRect.y;
+    float x1 = (float)(_destRect.x + _destRect.w), y1 = (float)(_destRect.y + _destRect.h);
+
+    // two triangles per quad: TL TR BR, TL BR BL
+    int first = (int)vertices.size();
+    vertices.push_back({{x0, y0}, _colour, {u0, v0}});
+    vertices.push_back({{x1, y0}, _colour, {u1, v0}});
+    vertices.push_back({{x1, y1}, _colour, {u1, v1}});
+    vertices.push_back({{x0, y1}, _colour, {u0, v1}});
+
+    for (int i : {0, 1, 2, 0, 2, 3}) {
+        indices.push_back(first + i);
+    }
+}
+
+bool SpriteBatch::Flush() {
+    bool success = Draw();
+    Clear();
+    return success;
+}
+
+bool SpriteBatch::Draw() const {
+    if (vertices.empty()) return true;
+
+    if (SDL_RenderGeometry(window.renderer, texture, vertices.data(), (int)vertices.size(),
+                           indices.data(), (int)indices.size()) != 0) {
+        LogError("Failed to draw sprite batch", SDL_GetError(), false);
+        return false;
+    }
+
+    return true;
+}
+
+void SpriteBatch::Clear() {
+    vertices.clear();
+    indices.clear();
+}
@@ -0,0 +1,165 @@
+//
+// Created by cew05 on 19/10/2026.
+//
+
+#include "AnalysisCache.h"
+
+#include <cstring>
+#include <filesystem>
+#include <sstream>
+
+bool AnalysisCache::Open(const std::string& _path, uint64_t _nSlots) {
+    /*
+     * Opens the cache file, creating it with _nSlots empty slots if it does not exist. A file with a different layout
+     * is left alone and the open fails, the file is shared with other processes that may still be using it.
+     */
+
+    if (_nSlots == 0) return false;
+
+    // Mapping a larger size would grow an existing file, so a file of another size is turned away before it is opened
+    uint64_t fileSize = headerSize + _nSlots * sizeof(Slot);
+    std::error_code ec;
+    uint64_t existingSize = std::filesystem::exists(_path, ec) ? std::filesystem::file_size(_path, ec) : 0;
+    if (!ec && existingSize != 0 && existingSize != fileSize) {
+        printf("Analysis cache %s has a different layout (%ju bytes), not using it. Delete it or set AnalysisCacheSlots "
+               "to match\n", _path.c_str(), (uintmax_t)existingSize);
+        return false;
+    }
+
+    if (!cacheFile.OpenReadWrite(_path, fileSize)) {
+        printf("Failed to open analysis cache %s\n", _path.c_str());
+        return false;
+    }
+
+    // Header: magic, version, slot count. A zeroed header is a new file
+    uint32_t* header = (uint32_t*)cacheFile.MutableData();
+    if (header[0] == 0 && header[1] == 0 && header[2] == 0) {
+        header[0] = magic;
+        header[1] = version;
+        header[2] = uint32_t(_nSlots);
+    }
+    else if (header[0] != magic || header[1] != version || header[2] != uint32_t(_nSlots) ||
+             cacheFile.Size() != fileSize) {
+        printf("Analysis cache %s has a different layout (%u slots), not using it. Delete it or set AnalysisCacheSlots "
+               "to match\n", _path.c_str(), header[2]);
+        cacheFile.Close();
+        return false;
+    }
+
+    slots = (Slot*)(cacheFile.MutableData() + headerSize);
+    nSlots = _nSlots;
+    return true;
+}
+
+uint64_t AnalysisCache::HashPosition(const std::string& _FEN) {
+    /*
+     * FNV-1a hash of the placement, side to move, castling and en passant fields. Move counters are ignored so that
+     * transpositions share an entry.
+     */
+
+    std::istringstream ss(_FEN);
+    std::string field, position;
+    for (int f = 0; f < 4 && ss >> field; f++) {
+        position += field + " ";
+    }
+
+    uint64_t hash = 0xcbf29ce484222325;
+    for (char c : position) {
+        hash ^= (unsigned char)c;
+        hash *= 0x100000001b3;
+    }
+    return hash;
+}
+
+uint64_t AnalysisCache::CreateKey(const std::string& _FEN, const std::string& _searchParams) {
+    uint64_t hash = HashPosition(_FEN);
+    for (char c : _searchParams) {
+        hash ^= (unsigned char)c;
+        hash *= 0x100000001b3;
+    }
+
+    // 0 marks an empty slot
+    return (hash == 0) ? 1 : hash;
+}
+
+uint64_t AnalysisCache::PackResult(const AnalysisResult& _result, uint64_t& _data1) {
+    // data0: up to 5 move chars, depth, mate flag. data1: score
+    uint64_t data0 = 0;
+    for (int c = 0; c < 5 && c < _result.bestMove.length(); c++) {
+        data0 |= uint64_t((unsigned char)_result.bestMove[c]) << (8*c);
+    }
+    data0 |= uint64_t(std::min(std::max(_result.depth, 0), 255)) << 40;
+    data0 |= uint64_t(_result.mateScore) << 48;
+
+    _data1 = uint64_t(uint32_t(int32_t(_result.score)));
+    return data0;
+}
+
+AnalysisResult AnalysisCache::UnpackResult(uint64_t _data0, uint64_t _data1) {
+    AnalysisResult result;
+    for (int c = 0; c < 5; c++) {
+        char moveChar = char((_data0 >> (8*c)) & 0xFF);
+        if (moveChar == 0) break;
+        result.bestMove += moveChar;
+    }
+    result.depth = int((_data0 >> 40) & 0xFF);
+    result.mateScore = ((_data0 >> 48) & 1) != 0;
+    result.score = int32_t(uint32_t(_data1 & 0xFFFFFFFF));
+    return result;
+}
+
+bool AnalysisCache::Probe(uint64_t _key, AnalysisResult& _result) const {
+    if (!IsOpen()) return false;
+
+    for (int p = 0; p < probeLength; p++) {
+        const volatile Slot& slot = slots[(_key + p) % nSlots];
+
+        // copy the slot before verifying, another process may be writing to it
+        uint64_t key = slot.key, data0 = slot.data0, data1 = slot.data1, check = slot.check;
+        if (key == 0) return false;
+        if (key != _key) continue;
+
+        // torn write, treat as a miss
+        if ((key ^ data0 ^ data1) != check) return false;
+
+        _result = UnpackResult(data0, data1);
+        return !_result.bestMove.empty();
+    }
+
+    return false;
+}
+
+void AnalysisCache::Store(uint64_t _key, const AnalysisResult& _result) {
+    /*
+     * Stores in the first empty or matching slot of the probe sequence, otherwise replaces the shallowest result.
+     */
+
+    if (!IsOpen() || _result.bestMove.empty()) return;
+
+    Slot* replace = nullptr;
+    int replaceDepth = 256;
+
+    for (int p = 0; p < probeLength; p++) {
+        Slot* slot = &slots[(_key + p) % nSlots];
+
+        if (slot->key == 0 || slot->key == _key) {
+            replace = slot;
+            break;
+        }
+
+        int depth = UnpackResult(slot->data0, slot->data1).depth;
+        if (depth < replaceDepth) {
+            replace = slot;
+            replaceDepth = depth;
+        }
+    }
+
+    // write the check word last
+    uint64_t data1;
+    uint64_t data0 = PackResult(_result, data1);
+    volatile Slot* slot = replace;
+    slot->key = _key;
+    slot->data0 = data0;
+    slot->data1 = data1;
+    slot->check = _key ^ data0 ^ data1;
+}
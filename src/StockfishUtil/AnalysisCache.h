@@ -0,0 +1,63 @@
+//
+// Created by cew05 on 19/10/2026.
+//
+
+#ifndef CHESS_WITH_SDL_ANALYSISCACHE_H
+#define CHESS_WITH_SDL_ANALYSISCACHE_H
+
+#include <string>
+#include <cstdint>
+
+#include "../src_headers/MappedFile.h"
+
+/*
+ * Fixed size, open addressed cache of engine results stored in a memory mapped file so that results survive restarts.
+ * Slots are written without locks; each slot stores a check word (key ^ data) so a reader in another process can
+ * detect and ignore a slot that is half written.
+ */
+
+struct AnalysisResult {
+    std::string bestMove {};
+    int score = 0;
+    bool mateScore = false;
+    int depth = 0;
+};
+
+class AnalysisCache {
+    private:
+        // File layout
+        static const uint32_t magic = 0x43534143; // "CSAC"
+        static const uint32_t version = 1;
+        static const uint64_t headerSize = 64;
+        static const int probeLength = 8;
+
+        struct Slot {
+            uint64_t key;
+            uint64_t data0;
+            uint64_t data1;
+            uint64_t check;
+        };
+
+        MappedFile cacheFile {};
+        Slot* slots = nullptr;
+        uint64_t nSlots = 0;
+
+        static uint64_t PackResult(const AnalysisResult& _result, uint64_t& _data1);
+        static AnalysisResult UnpackResult(uint64_t _data0, uint64_t _data1);
+
+    public:
+        AnalysisCache() = default;
+
+        bool Open(const std::string& _path, uint64_t _nSlots);
+        [[nodiscard]] bool IsOpen() const { return slots != nullptr; };
+
+        // Keys
+        static uint64_t HashPosition(const std::string& _FEN);
+        static uint64_t CreateKey(const std::string& _FEN, const std::string& _searchParams);
+
+        // Lookup / store
+        bool Probe(uint64_t _key, AnalysisResult& _result) const;
+        void Store(uint64_t _key, const AnalysisResult& _result);
+};
+
+#endif //CHESS_WITH_SDL_ANALYSISCACHE_H
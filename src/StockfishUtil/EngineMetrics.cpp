@@ -0,0 +1,100 @@
+//
+// Created by cew05 on 19/10/2026.
+//
+
+#include "EngineMetrics.h"
+
+#include <fstream>
+#include <algorithm>
+#include <cstdio>
+
+/*
+ * LatencyHistogram
+ */
+
+int LatencyHistogram::BucketIndex(uint64_t _value) {
+    // values below 2*subBuckets are stored exactly
+    if (_value < 2 * subBuckets) return int(_value);
+
+    // otherwise keep the top subBucketBits+1 bits of the value
+    int msb = 63;
+    while (!(_value >> msb)) msb--;
+    if (msb >= maxBits) return (maxBits - subBucketBits + 2) * subBuckets - 1;
+
+    int shift = msb - subBucketBits;
+    return (shift + 1) * subBuckets + int((_value >> shift) - subBuckets);
+}
+
+uint64_t LatencyHistogram::BucketValue(int _index) {
+    // lowest value stored in the bucket
+    if (_index < 2 * subBuckets) return _index;
+
+    int shift = _index / subBuckets - 1;
+    return uint64_t(subBuckets + _index % subBuckets) << shift;
+}
+
+void LatencyHistogram::Record(uint64_t _value) {
+    counts[BucketIndex(_value)]++;
+    total++;
+    minValue = std::min(minValue, _value);
+    maxValue = std::max(maxValue, _value);
+}
+
+void LatencyHistogram::Reset() {
+    std::fill(counts.begin(), counts.end(), 0);
+    total = 0;
+    minValue = UINT64_MAX;
+    maxValue = 0;
+}
+
+uint64_t LatencyHistogram::Percentile(double _percentile) const {
+    if (total == 0) return 0;
+
+    // rank of the requested sample, then walk buckets until reached
+    auto rank = uint64_t(_percentile / 100.0 * double(total));
+    rank = std::max(rank, (uint64_t)1);
+
+    uint64_t seen = 0;
+    for (int b = 0; b < counts.size(); b++) {
+        seen += counts[b];
+        // report the highest value in the bucket, HDR style
+        if (seen >= rank) return std::min(std::max(BucketValue(b + 1) - 1, Min()), maxValue);
+    }
+
+    return maxValue;
+}
+
+/*
+ * EngineMetrics
+ */
+
+bool EngineMetrics::DumpToFile(const std::string& _path) const {
+    std::ofstream file(_path, std::ios::trunc);
+    if (!file.good()) {
+        printf("Failed to write engine metrics to %s\n", _path.c_str());
+        return false;
+    }
+
+    // counters
+    file << "engine_requests_total " << requests << "\n";
+    file << "engine_timeouts_total " << timeouts << "\n";
+    file << "engine_restarts_total " << restarts << "\n";
+    file << "engine_failures_total " << failures << "\n";
+
+    // latency summaries
+    const std::pair<std::string, const LatencyHistogram*> histograms[2] = {
+            {"engine_first_info_latency_us", &firstInfoLatency},
+            {"engine_bestmove_latency_us", &bestMoveLatency},
+    };
+    const double percentiles[5] = {50, 90, 99, 99.9, 100};
+
+    for (const auto& histogram : histograms) {
+        for (double p : percentiles) {
+            file << histogram.first << "{quantile=\"" << p / 100.0 << "\"} " << histogram.second->Percentile(p) << "\n";
+        }
+        file << histogram.first << "_count " << histogram.second->Count() << "\n";
+        file << histogram.first << "_min " << histogram.second->Min() << "\n";
+    }
+
+    return true;
+}
@@ -0,0 +1,57 @@
+//
+// Created by cew05 on 19/10/2026.
+//
+
+#ifndef CHESS_WITH_SDL_ENGINEMETRICS_H
+#define CHESS_WITH_SDL_ENGINEMETRICS_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+/*
+ * HDR style latency histogram. Values are stored in log-linear buckets (subBuckets per power of two), giving a fixed
+ * ~3% relative error at any magnitude without storing individual samples.
+ */
+
+class LatencyHistogram {
+    private:
+        static const int subBucketBits = 5;
+        static const int subBuckets = 1 << subBucketBits;
+        static const int maxBits = 40;
+
+        std::vector<uint64_t> counts = std::vector<uint64_t>((maxBits - subBucketBits + 2) * subBuckets, 0);
+        uint64_t total = 0;
+        uint64_t minValue = UINT64_MAX;
+        uint64_t maxValue = 0;
+
+        static int BucketIndex(uint64_t _value);
+        static uint64_t BucketValue(int _index);
+
+    public:
+        void Record(uint64_t _value);
+        void Reset();
+
+        [[nodiscard]] uint64_t Percentile(double _percentile) const;
+        [[nodiscard]] uint64_t Count() const { return total; };
+        [[nodiscard]] uint64_t Min() const { return total == 0 ? 0 : minValue; };
+        [[nodiscard]] uint64_t Max() const { return maxValue; };
+};
+
+/*
+ * Engine request timings (microseconds) and health counters, written to a metrics file as "name value" lines.
+ */
+
+struct EngineMetrics {
+    LatencyHistogram firstInfoLatency {};
+    LatencyHistogram bestMoveLatency {};
+
+    uint64_t requests = 0;
+    uint64_t timeouts = 0;
+    uint64_t restarts = 0;
+    uint64_t failures = 0;
+
+    bool DumpToFile(const std::string& _path) const;
+};
+
+#endif //CHESS_WITH_SDL_ENGINEMETRICS_H
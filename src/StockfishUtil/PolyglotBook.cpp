@@ -0,0 +1,211 @@
+//
+// Created by cew05 on 19/10/2026.
+//
+
+#include "PolyglotBook.h"
+
+#include <fstream>
+#include <sstream>
+
+/*
+ * Local helpers
+ */
+
+static uint64_t ReadBigEndian(const unsigned char* _bytes, int _nBytes) {
+    uint64_t value = 0;
+    for (int b = 0; b < _nBytes; b++) {
+        value = (value << 8) | _bytes[b];
+    }
+    return value;
+}
+
+static int PolyglotPieceKind(char _piece) {
+    // Polyglot orders pieces as black pawn, white pawn, black knight, white knight ... black king, white king
+    const std::string order = "pPnNbBrRqQkK";
+    size_t index = order.find(_piece);
+    return (index == std::string::npos) ? -1 : int(index);
+}
+
+/*
+ * PolyglotBook
+ */
+
+bool PolyglotBook::Open(const std::string& _bookPath, const std::string& _randomPath) {
+    if (!LoadKeys(_randomPath)) return false;
+
+    // Map book
+    if (!bookFile.OpenRead(_bookPath)) {
+        printf("No opening book found at %s, opening book disabled\n", _bookPath.c_str());
+        return false;
+    }
+    nEntries = bookFile.Size() / entrySize;
+
+    printf("Opened opening book %s with %llu entries\n", _bookPath.c_str(), (unsigned long long)nEntries);
+    return true;
+}
+
+bool PolyglotBook::LoadKeys(const std::string& _randomPath) {
+    // Read Random64 key table
+    random64.clear();
+    std::ifstream randomFile(_randomPath, std::ios::binary);
+    if (!randomFile.good()) {
+        printf("No Polyglot Random64 table found at %s, opening book disabled\n", _randomPath.c_str());
+        return false;
+    }
+
+    unsigned char bytes[8];
+    while (random64.size() < nRandom && randomFile.read((char*)bytes, sizeof(bytes))) {
+        random64.push_back(ReadBigEndian(bytes, 8));
+    }
+    if (random64.size() != nRandom) {
+        printf("Polyglot Random64 table %s is incomplete (%zu of %d values)\n", _randomPath.c_str(), random64.size(),
+               nRandom);
+        random64.clear();
+        return false;
+    }
+
+    return true;
+}
+
+PolyglotBook::Entry PolyglotBook::ReadEntry(uint64_t _index) const {
+    const unsigned char* bytes = bookFile.Data() + _index * entrySize;
+    return {ReadBigEndian(bytes, 8), uint16_t(ReadBigEndian(bytes + 8, 2)), uint16_t(ReadBigEndian(bytes + 10, 2))};
+}
+
+uint64_t PolyglotBook::CreateKey(const std::string& _FEN) const {
+    /*
+     * Creates the Polyglot key from the piece placement, side to move, castling and en passant fields of a FEN
+     * string. The en passant file only counts when a pawn of the side to move can actually make the capture.
+     */
+
+    if (random64.size() != nRandom) return 0;
+
+    std::istringstream ss(_FEN);
+    std::string placement, turn, castling, passant;
+    ss >> placement >> turn >> castling >> passant;
+
+    uint64_t key = 0;
+
+    // Pieces. FEN starts at a8, polyglot rows start at rank 1
+    char board[64] {};
+    int row = 7, file = 0;
+    for (char c : placement) {
+        if (c == '/') { row--; file = 0; continue; }
+        if (isdigit(c)) { file += c - '0'; continue; }
+
+        int kind = PolyglotPieceKind(c);
+        if (kind >= 0 && row >= 0 && file < 8) {
+            board[row*8 + file] = c;
+            key ^= random64[64*kind + 8*row + file];
+        }
+        file++;
+    }
+
+    // Castling rights
+    if (castling.find('K') != std::string::npos) key ^= random64[randomCastle + 0];
+    if (castling.find('Q') != std::string::npos) key ^= random64[randomCastle + 1];
+    if (castling.find('k') != std::string::npos) key ^= random64[randomCastle + 2];
+    if (castling.find('q') != std::string::npos) key ^= random64[randomCastle + 3];
+
+    // En passant, only when a side to move pawn is beside the pawn that moved two
+    bool whiteToMove = (turn != "b");
+    if (passant.length() == 2 && passant[0] >= 'a' && passant[0] <= 'h') {
+        int epFile = passant[0] - 'a';
+        int pawnRow = whiteToMove ? 4 : 3;
+        char pawn = whiteToMove ? 'P' : 'p';
+
+        if ((epFile > 0 && board[pawnRow*8 + epFile - 1] == pawn) ||
+            (epFile < 7 && board[pawnRow*8 + epFile + 1] == pawn)) {
+            key ^= random64[randomPassant + epFile];
+        }
+    }
+
+    // Side to move
+    if (whiteToMove) key ^= random64[randomTurn];
+
+    return key;
+}
+
+std::string PolyglotBook::MoveToString(uint16_t _move, const char _board[64]) {
+    /*
+     * Converts a polyglot move into the [position][destination][promotion] string used by the engine. Polyglot
+     * represents castling as the king capturing its own rook, which is changed into the kings two square move.
+     */
+
+    int toFile = _move & 7, toRow = (_move >> 3) & 7;
+    int fromFile = (_move >> 6) & 7, fromRow = (_move >> 9) & 7;
+    int promotion = (_move >> 12) & 7;
+
+    char king = _board[fromRow*8 + fromFile];
+    if ((king == 'K' || king == 'k') && fromFile == 4 && toRow == fromRow) {
+        if (toFile == 7) toFile = 6;
+        else if (toFile == 0) toFile = 2;
+    }
+
+    std::string move;
+    move += char('a' + fromFile);
+    move += char('1' + fromRow);
+    move += char('a' + toFile);
+    move += char('1' + toRow);
+    if (promotion > 0 && promotion < 5) move += " nbrq"[promotion];
+
+    return move;
+}
+
+std::string PolyglotBook::FetchMove(const std::string& _FEN) {
+    /*
+     * Returns a weighted random book move for the position, or an empty string when the position is not in the book.
+     */
+
+    if (!IsOpen()) return {};
+
+    uint64_t key = CreateKey(_FEN);
+
+    // binary search for the first entry with the key
+    uint64_t low = 0, high = nEntries;
+    while (low < high) {
+        uint64_t mid = low + (high - low) / 2;
+        if (ReadEntry(mid).key < key) low = mid + 1;
+        else high = mid;
+    }
+
+    // collect all weighted entries with the key
+    std::vector<Entry> entries;
+    uint32_t totalWeight = 0;
+    for (uint64_t e = low; e < nEntries; e++) {
+        Entry entry = ReadEntry(e);
+        if (entry.key != key) break;
+        if (entry.weight == 0) continue;
+
+        entries.push_back(entry);
+        totalWeight += entry.weight;
+    }
+    if (entries.empty()) return {};
+
+    // pick an entry in proportion to its weight
+    uint32_t pick = std::uniform_int_distribution<uint32_t>(0, totalWeight - 1)(rng);
+    Entry chosen = entries.back();
+    for (const auto& entry : entries) {
+        if (pick < entry.weight) {
+            chosen = entry;
+            break;
+        }
+        pick -= entry.weight;
+    }
+
+    // Rebuild board to detect castling moves
+    std::istringstream ss(_FEN);
+    std::string placement;
+    ss >> placement;
+
+    char board[64] {};
+    int row = 7, file = 0;
+    for (char c : placement) {
+        if (c == '/') { row--; file = 0; continue; }
+        if (isdigit(c)) { file += c - '0'; continue; }
+        if (row >= 0 && file < 8) board[row*8 + file] = c;
+        file++;
+    }
+
+    return MoveToString(chosen.move, board);
+}
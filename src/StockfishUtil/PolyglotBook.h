@@ -0,0 +1,56 @@
+//
+// Created by cew05 on 19/10/2026.
+//
+
+#ifndef CHESS_WITH_SDL_POLYGLOTBOOK_H
+#define CHESS_WITH_SDL_POLYGLOTBOOK_H
+
+#include <string>
+#include <vector>
+#include <random>
+#include <cstdint>
+
+#include "../src_headers/MappedFile.h"
+
+/*
+ * Read only Polyglot opening book. The .bin file is memory mapped and binary searched by the Polyglot Zobrist key of a
+ * FEN string. The 781 Random64 values that make up the key are read from a separate big-endian file so that the book
+ * and its key table are always shipped together.
+ */
+
+class PolyglotBook {
+    private:
+        // Polyglot file layout
+        static const int entrySize = 16;
+        static const int nRandom = 781;
+        static const int randomCastle = 768;
+        static const int randomPassant = 772;
+        static const int randomTurn = 780;
+
+        MappedFile bookFile {};
+        uint64_t nEntries = 0;
+        std::vector<uint64_t> random64 {};
+
+        std::mt19937 rng {std::random_device{}()};
+
+        struct Entry {
+            uint64_t key;
+            uint16_t move;
+            uint16_t weight;
+        };
+
+        [[nodiscard]] Entry ReadEntry(uint64_t _index) const;
+        [[nodiscard]] static std::string MoveToString(uint16_t _move, const char _board[64]);
+
+    public:
+        PolyglotBook() = default;
+
+        bool Open(const std::string& _bookPath, const std::string& _randomPath);
+        bool LoadKeys(const std::string& _randomPath);
+        [[nodiscard]] bool IsOpen() const { return bookFile.IsOpen() && random64.size() == nRandom; };
+
+        [[nodiscard]] uint64_t CreateKey(const std::string& _FEN) const;
+        std::string FetchMove(const std::string& _FEN);
+};
+
+#endif //CHESS_WITH_SDL_POLYGLOTBOOK_H
@@ -4,8 +4,242 @@
 
 #include "StockfishManager.h"
 
-StockfishManager::StockfishManager() {
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+StockfishManager::StockfishManager() = default;
+
+void StockfishManager::StartAsync() {
+    /*
+     * Spawns the engine and runs the uci / isready handshake on a background thread, so that engine startup (including
+     * loading the NNUE net) does not block the caller.
+     */
+
+    if (launchThread.joinable() || ready) return;
+
+    LaunchAsync();
+}
+
+void StockfishManager::LaunchAsync() {
+    launching = true;
+    launchFailed = false;
+    launchThread = std::thread([this]() {
+        if (!Launch()) launchFailed = true;
+        launching = false;
+    });
+}
+
+bool StockfishManager::WaitUntilReady() {
+    // Blocks until the handshake has completed. Returns false if the engine failed to start
+    if (launchThread.joinable()) launchThread.join();
+
+    return ready;
+}
+
+bool StockfishManager::Launch() {
+    /*
+     * Starts the engine and runs the handshake. Every failure closes whatever pipes and process were opened so far
+     */
+
+    if (!SpawnEngine()) {
+        CloseEngine(0);
+        return false;
+    }
+
+    // Run handshake, a hung engine is abandoned after startupTimeout
+    WriteCommand("uci\n");
+    if (!ReadUntil("uciok", startupTimeout)) {
+        printf("Stockfish did not reply to uci\n");
+        CloseEngine(0);
+        return false;
+    }
+    WriteCommand("isready\n");
+    if (!ReadUntil("readyok", startupTimeout)) {
+        printf("Stockfish did not reply to isready\n");
+        CloseEngine(0);
+        return false;
+    }
+    printf("STOCKFISH READY\n");
+
+    // Handshake complete, send any commands queued during startup
+    std::lock_guard<std::mutex> lock(commandMutex);
+    for (const auto& cmd : pendingCommands) {
+        WriteCommand(cmd);
+    }
+    pendingCommands.clear();
+    ready = true;
+
+    return true;
+}
+
+StockfishManager::~StockfishManager() {
+    // Engine must finish starting before it can be closed
+    WaitUntilReady();
+    DumpMetrics();
+
+    CloseEngine(quitWait);
+    printf("NOTICE: STOCKFISH CLOSED");
+}
+
+void StockfishManager::Restart() {
+    /*
+     * Kills a stuck engine and starts a new one in the background, replaying the options and last position sent to
+     * the old engine. The caller does not wait for it, searches fail until the new engine is ready.
+     */
+
+    printf("ENGINE WATCHDOG: RESTARTING STOCKFISH\n");
+    metrics.restarts++;
+
+    // the previous launch has finished, the engine was ready
+    if (launchThread.joinable()) launchThread.join();
+    CloseEngine(0);
+
+    {
+        std::lock_guard<std::mutex> lock(commandMutex);
+        pendingCommands = optionCommands;
+        pendingCommands.emplace_back("ucinewgame\n");
+        if (!lastPositionCommand.empty()) pendingCommands.push_back(lastPositionCommand);
+    }
+
+    LaunchAsync();
+}
+
+bool StockfishManager::DoFunction(const std::string& _cmd) {
+    // Queue the command if the engine has not finished starting
+    std::lock_guard<std::mutex> lock(commandMutex);
+    if (!ready) {
+        if (launchFailed) return false;
+
+        pendingCommands.push_back(_cmd);
+        if (_cmd.compare(0, 10, "setoption ") == 0) optionCommands.push_back(_cmd);
+        return true;
+    }
+
+    // options are kept to be replayed after a watchdog restart
+    if (_cmd.compare(0, 10, "setoption ") == 0) optionCommands.push_back(_cmd);
+    return WriteCommand(_cmd);
+}
+
+bool StockfishManager::ReadLine(std::string& _line, unsigned long _timeoutMs) {
+    /*
+     * Returns the next line of engine output without its newline. Polls the pipe so that a hung or closed engine
+     * returns false after _timeoutMs instead of blocking forever.
+     */
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(_timeoutMs);
+
+    while (true) {
+        // return a complete line if one has been read
+        size_t pos = outputBuffer.find('\n');
+        if (pos != std::string::npos) {
+            _line = outputBuffer.substr(0, pos);
+            if (!_line.empty() && _line.back() == '\r') _line.pop_back();
+            outputBuffer.erase(0, pos + 1);
+            return true;
+        }
+
+        // read whatever is available
+        int nRead = ReadAvailable();
+        if (nRead < 0) return false;
+        if (nRead > 0) continue;
+
+        // nothing to read, stop if the engine has exited or the timeout has passed
+        if (HasExited()) return false;
+        if (std::chrono::steady_clock::now() >= deadline) return false;
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+bool StockfishManager::ReadUntil(const std::string& _token, unsigned long _timeoutMs, std::vector<std::string>* _lines) {
+    // Reads lines until one starts with _token
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(_timeoutMs);
+    std::string line;
+
+    while (true) {
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+        if (remaining.count() <= 0 || !ReadLine(line, (unsigned long)remaining.count())) return false;
+
+        if (_lines != nullptr) _lines->push_back(line);
+        if (line.compare(0, _token.length(), _token) == 0) return true;
+    }
+}
+
+bool StockfishManager::SearchBestMove(const std::string& _positionCmd, const std::string& _goCmd, unsigned long _timeoutMs,
+                                      std::vector<std::string>& _lines) {
+    /*
+     * Sends the position and go commands then reads lines until bestmove. Records send-to-first-info and
+     * send-to-bestmove latency. If no bestmove arrives within _timeoutMs the engine is told to stop; if it still does
+     * not reply it is restarted in the background and the search fails, the caller retries once IsReady.
+     */
+
+    if (!ready) return false;
+
+    lastPositionCommand = _positionCmd;
+    _lines.clear();
+    DoFunction(_positionCmd);
+    DoFunction(_goCmd);
+
+    auto sendTime = std::chrono::steady_clock::now();
+    auto deadline = sendTime + std::chrono::milliseconds(_timeoutMs);
+    bool firstInfo = true;
+    std::string line;
+
+    while (true) {
+        auto now = std::chrono::steady_clock::now();
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now);
+        if (remaining.count() <= 0 || !ReadLine(line, (unsigned long)remaining.count())) break;
+
+        _lines.push_back(line);
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - sendTime);
+
+        if (firstInfo && line.compare(0, 5, "info ") == 0) {
+            metrics.firstInfoLatency.Record(elapsed.count());
+            firstInfo = false;
+        }
+
+        if (line.compare(0, 9, "bestmove ") == 0) {
+            metrics.bestMoveLatency.Record(elapsed.count());
+            metrics.requests++;
+            if (metricsDumpInterval > 0 && metrics.requests % metricsDumpInterval == 0) DumpMetrics();
+            return true;
+        }
+    }
+
+    // Timed out, ask for the best move found so far
+    metrics.timeouts++;
+    printf("ENGINE WATCHDOG: NO BESTMOVE AFTER %lums\n", _timeoutMs);
+    if (!HasExited()) {
+        DoFunction("stop\n");
+        if (ReadUntil("bestmove ", stopGrace, &_lines)) {
+            metrics.requests++;
+            return true;
+        }
+    }
+
+    // engine is stuck or has died
+    metrics.failures++;
+    DumpMetrics();
+    Restart();
+    return false;
+}
+
+bool StockfishManager::DumpMetrics() const {
+    if (metricsPath.empty()) return false;
+
+    return metrics.DumpToFile(metricsPath);
+}
+
+/*
+ * PLATFORM LAYER
+ */
+
+#ifdef _WIN32
+
+bool StockfishManager::SpawnEngine() {
     // Set Security Attributes
+    SECURITY_ATTRIBUTES secAttr {};
     secAttr.nLength = sizeof(SECURITY_ATTRIBUTES);
     secAttr.bInheritHandle = true;
     secAttr.lpSecurityDescriptor = nullptr;
@@ -13,19 +247,21 @@ StockfishManager::StockfishManager() {
     // Create Pipes
     if (!CreatePipe(&rbOutputPipe, &wbOutputPipe, &secAttr, 0)) {
         printf("Failed to create pipe: %lu\n", GetLastError());
-        return;
+        return false;
     }
     if (!CreatePipe(&rbInputPipe, &wbInputPipe, &secAttr, 0)) {
         printf("Failed to create pipe: %lu\n", GetLastError());
-        return;
+        return false;
     }
 
     // Set Startup Info
+    STARTUPINFO si {};
     si.cb = sizeof(si);
     si.hStdOutput = wbOutputPipe;
     si.hStdInput = rbInputPipe;
     si.dwFlags |= STARTF_USESTDHANDLES;
 
+    PROCESS_INFORMATION pi {};
     if (!CreateProcessA("../stockfish/stockfish-windows-x86-64-avx2.exe",
                         nullptr,
                         nullptr,
@@ -37,53 +273,53 @@ StockfishManager::StockfishManager() {
                         &si,
                         &pi)) {
         printf("Failed to create stockfish process. EC: %lu\n", GetLastError());
-        return;
+        return false;
     }
 
-    // Fetch initialisation string to confirm success
-    printf("INIT : %s\n", FetchResult().c_str());
-
-    DoFunction("uci\n");
-    printf("%s\n", FetchResult().c_str());
-    DoFunction("isready\n");
-    printf("%s\n", FetchResult().c_str());
+    process = pi.hProcess;
+    processThread = pi.hThread;
+    return true;
 }
 
-StockfishManager::~StockfishManager() {
-    // Run quit command
-    DoFunction("quit\n");
+void StockfishManager::CloseEngine(unsigned long _waitMs) {
+    /*
+     * Asks the engine to quit, force terminating it if it has not closed after _waitMs, then closes all handles.
+     */
 
-    // Ensure that the program has closed
-    auto result = WaitForSingleObject(pi.hProcess, 600);
-    if (result != WAIT_OBJECT_0) {
-        // took too long to close
-        printf("Termination took too long, force terminate.\n");
-        TerminateProcess(pi.hProcess, EXIT_FAILURE);
-    }
+    if (process != nullptr) {
+        WriteCommand("quit\n");
 
-    // Close handles
-    CloseHandle(pi.hProcess);
-    CloseHandle(pi.hThread);
+        // Ensure that the program has closed
+        auto result = WaitForSingleObject(process, _waitMs);
+        if (result != WAIT_OBJECT_0) {
+            // took too long to close
+            printf("Termination took too long, force terminate.\n");
+            TerminateProcess(process, EXIT_FAILURE);
+        }
 
-    printf("NOTICE: STOCKFISH CLOSED");
-}
+        // Close handles
+        CloseHandle(process);
+        CloseHandle(processThread);
+    }
 
-bool StockfishManager::DoFunction(const std::string& _cmd) {
-    // Turn string command into char list
-    char cmd[_cmd.length()];
-    for (int c = 0; c < _cmd.length(); c++) {
-        cmd[c] = _cmd[c];
+    for (void** handle : {&wbOutputPipe, &rbOutputPipe, &wbInputPipe, &rbInputPipe}) {
+        if (*handle != nullptr) CloseHandle(*handle);
+        *handle = nullptr;
     }
 
-    //printf("REMOVETHISMESSAGE recieved command [%s]\n", _cmd.c_str());
+    process = nullptr;
+    processThread = nullptr;
+    outputBuffer.clear();
+    ready = false;
+}
 
+bool StockfishManager::WriteCommand(const std::string& _cmd) {
     // Now send the command
-    if (WriteFile(wbInputPipe, cmd, sizeof(cmd), &bytesWritten, nullptr) != TRUE) {
+    DWORD bytesWritten = 0;
+    if (WriteFile(wbInputPipe, _cmd.data(), (DWORD)_cmd.length(), &bytesWritten, nullptr) != TRUE) {
         printf("Failed to write to pipe: %lu\n", GetLastError());
     }
 
-    //printf("REMOVETHISMESSAGE sent command [%s]\n", cmd);
-
     return true;
 }
 
@@ -95,6 +331,7 @@ std::string StockfishManager::FetchResult() {
     while (!end) {
         std::string contentsString {};
         char contents[bufferSize] {0};
+        DWORD bytesRead = 0;
         if (ReadFile(rbOutputPipe, &contents, bufferSize, &bytesRead, nullptr) != TRUE) {
             printf("Failed to read pipe: %lu\n", GetLastError());
             return {};
@@ -115,3 +352,57 @@ std::string StockfishManager::FetchResult() {
     return response;
 }
 
+int StockfishManager::ReadAvailable() {
+    // Appends whatever output is waiting to outputBuffer without blocking. Returns the bytes read, -1 on error
+    DWORD available = 0;
+    if (!PeekNamedPipe(rbOutputPipe, nullptr, 0, nullptr, &available, nullptr)) {
+        printf("Failed to peek pipe: %lu\n", GetLastError());
+        return -1;
+    }
+    if (available == 0) return 0;
+
+    char contents[bufferSize];
+    DWORD bytesRead = 0;
+    if (ReadFile(rbOutputPipe, contents, std::min(available, bufferSize), &bytesRead, nullptr) != TRUE) {
+        printf("Failed to read pipe: %lu\n", GetLastError());
+        return -1;
+    }
+    outputBuffer.append(contents, bytesRead);
+    return (int)bytesRead;
+}
+
+bool StockfishManager::HasExited() {
+    return process == nullptr || WaitForSingleObject(process, 0) == WAIT_OBJECT_0;
+}
+
+#else
+
+// The engine binary shipped is windows only, other builds run without it
+
+bool StockfishManager::SpawnEngine() {
+    printf("Stockfish is only started on windows builds, engine disabled\n");
+    return false;
+}
+
+void StockfishManager::CloseEngine([[maybe_unused]] unsigned long _waitMs) {
+    outputBuffer.clear();
+    ready = false;
+}
+
+bool StockfishManager::WriteCommand([[maybe_unused]] const std::string& _cmd) {
+    return false;
+}
+
+std::string StockfishManager::FetchResult() {
+    return {};
+}
+
+int StockfishManager::ReadAvailable() {
+    return -1;
+}
+
+bool StockfishManager::HasExited() {
+    return true;
+}
+
+#endif
@@ -6,35 +6,96 @@
 #define CHESS_WITH_SDL_STOCKFISHMANAGER_H
 
 #include <iostream>
-#include <windows.h>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+
+#include "EngineMetrics.h"
+
+/*
+ * Runs Stockfish as a child process over pipes. Only windows builds start the engine; elsewhere launching fails and
+ * callers fall back as they would for a missing engine. Handles are kept opaque so windows.h stays out of this header,
+ * and times are in ms as unsigned long, the type of a windows DWORD.
+ */
 
 class StockfishManager {
     private:
         // Pipes to process
-        SECURITY_ATTRIBUTES secAttr;
-        HANDLE wbOutputPipe {};
-        HANDLE rbOutputPipe {};
-        HANDLE wbInputPipe {};
-        HANDLE rbInputPipe {};
+        void* wbOutputPipe = nullptr;
+        void* rbOutputPipe = nullptr;
+        void* wbInputPipe = nullptr;
+        void* rbInputPipe = nullptr;
 
         std::string inputPipeContents {};
 
-        static const DWORD bufferSize = 256;
-        DWORD bytesRead = 0;
-        DWORD bytesWritten = 0;
+        static constexpr unsigned long bufferSize = 256;
 
         // Stockfish Process
-        PROCESS_INFORMATION pi {};
-        STARTUPINFO si {};
+        void* process = nullptr;
+        void* processThread = nullptr;
+
+        // Background startup and watchdog restarts. Commands sent before readyok are queued and sent once the
+        // handshake completes
+        std::thread launchThread;
+        std::mutex commandMutex;
+        std::vector<std::string> pendingCommands {};
+        std::atomic<bool> ready = false;
+        std::atomic<bool> launching = false;
+        std::atomic<bool> launchFailed = false;
+
+        // Output read but not yet returned as a line
+        std::string outputBuffer {};
+
+        // Watchdog. Options and the last position are replayed to a restarted engine
+        std::vector<std::string> optionCommands {};
+        std::string lastPositionCommand {};
+        unsigned long startupTimeout = 10000;
+        unsigned long stopGrace = 500;
+        unsigned long quitWait = 600;
+
+        // Telemetry
+        EngineMetrics metrics {};
+        std::string metricsPath {};
+        int metricsDumpInterval = 10;
 
-        //
+        bool Launch();
+        void LaunchAsync();
+        void Restart();
+
+        // Platform layer
+        bool SpawnEngine();
+        void CloseEngine(unsigned long _waitMs);
+        bool WriteCommand(const std::string& _cmd);
+        int ReadAvailable();
+        bool HasExited();
+
+        bool ReadLine(std::string& _line, unsigned long _timeoutMs);
+        bool ReadUntil(const std::string& _token, unsigned long _timeoutMs, std::vector<std::string>* _lines = nullptr);
 
     public:
         StockfishManager();
         ~StockfishManager();
 
+        // Startup
+        void StartAsync();
+        bool WaitUntilReady();
+        [[nodiscard]] bool IsReady() const { return ready; };
+        [[nodiscard]] bool IsStarting() const { return launching; };
+
         bool DoFunction(const std::string& _cmd);
         std::string FetchResult();
+
+        // Search with watchdog
+        bool SearchBestMove(const std::string& _positionCmd, const std::string& _goCmd, unsigned long _timeoutMs,
+                            std::vector<std::string>& _lines);
+
+        // Telemetry
+        void SetMetricsFile(const std::string& _path) { metricsPath = _path; };
+        void SetQuitWait(unsigned long _waitMs) { quitWait = _waitMs; };
+        [[nodiscard]] const EngineMetrics& AccessMetrics() const { return metrics; };
+        bool DumpMetrics() const;
 };
 
 #endif //CHESS_WITH_SDL_STOCKFISHMANAGER_H
@@ -0,0 +1,96 @@
+//
+// Created by cew05 on 19/10/2026.
+//
+
+#include "TestRunner.h"
+#include "../StockfishUtil/AnalysisCache.h"
+
+#include <filesystem>
+
+static const std::string START_FEN = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+static std::string CachePath() {
+    return (std::filesystem::temp_directory_path() / "chess_analysiscache_test.bin").string();
+}
+
+/*
+ * KEYS
+ */
+
+TEST(AnalysisCacheKeys) {
+    // move counters do not change the position, the search parameters do
+    CHECK_EQ(AnalysisCache::HashPosition(START_FEN),
+             AnalysisCache::HashPosition("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 4 9"));
+    CHECK(AnalysisCache::CreateKey(START_FEN, "movetime 1000") != AnalysisCache::CreateKey(START_FEN, "movetime 2000"));
+    CHECK(AnalysisCache::CreateKey(START_FEN, "elo 1320 skill 1 movetime 1000") !=
+          AnalysisCache::CreateKey(START_FEN, "elo 1500 skill 1 movetime 1000"));
+    CHECK(AnalysisCache::CreateKey(START_FEN, "elo 1320 skill 1 movetime 1000") !=
+          AnalysisCache::CreateKey(START_FEN, "elo 1320 skill 10 movetime 1000"));
+}
+
+/*
+ * PROBE / STORE
+ */
+
+TEST(AnalysisCacheProbeStore) {
+    std::filesystem::remove(CachePath());
+
+    AnalysisCache cache;
+    CHECK(cache.Open(CachePath(), 64));
+
+    uint64_t key = AnalysisCache::CreateKey(START_FEN, "depth 10");
+    AnalysisResult result;
+    CHECK(!cache.Probe(key, result));
+
+    AnalysisResult stored {"e7e8q", -350, false, 18};
+    cache.Store(key, stored);
+    CHECK(cache.Probe(key, result));
+    CHECK_EQ(result.bestMove, stored.bestMove);
+    CHECK_EQ(result.score, stored.score);
+    CHECK_EQ(result.mateScore, stored.mateScore);
+    CHECK_EQ(result.depth, stored.depth);
+
+    // a different key is a miss, empty moves are never stored
+    CHECK(!cache.Probe(AnalysisCache::CreateKey(START_FEN, "depth 11"), result));
+    uint64_t emptyKey = AnalysisCache::CreateKey(START_FEN, "depth 12");
+    cache.Store(emptyKey, AnalysisResult {});
+    CHECK(!cache.Probe(emptyKey, result));
+
+    std::filesystem::remove(CachePath());
+}
+
+TEST(AnalysisCacheReopen) {
+    std::filesystem::remove(CachePath());
+    uint64_t key = AnalysisCache::CreateKey(START_FEN, "elo 1320 skill 1 movetime 1000");
+
+    {
+        AnalysisCache cache;
+        CHECK(cache.Open(CachePath(), 64));
+        cache.Store(key, {"g1f3", 3, true, 7});
+    }
+
+    // results survive the file being closed and opened again
+    {
+        AnalysisCache cache;
+        CHECK(cache.Open(CachePath(), 64));
+        AnalysisResult result;
+        CHECK(cache.Probe(key, result));
+        CHECK_EQ(result.bestMove, std::string("g1f3"));
+        CHECK(result.mateScore);
+    }
+
+    // a different slot count is a different layout, the file is left alone
+    {
+        AnalysisCache cache;
+        CHECK(!cache.Open(CachePath(), 128));
+        CHECK(!cache.IsOpen());
+    }
+    {
+        AnalysisCache cache;
+        CHECK(cache.Open(CachePath(), 64));
+        AnalysisResult result;
+        CHECK(cache.Probe(key, result));
+    }
+
+    std::filesystem::remove(CachePath());
+}
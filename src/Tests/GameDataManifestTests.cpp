@@ -0,0 +1,230 @@
+//
+// Created by cew05 on 19/10/2026.
+//
+
+#include "TestRunner.h"
+#include "../Gameplay/include/GameDataManifest.h"
+
+#include <chrono>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <thread>
+
+static const int64_t DAY = 24 * 60 * 60;
+
+static std::string GameDataDir() {
+    return (std::filesystem::temp_directory_path() / "chess_gamedata_test").string();
+}
+
+static void ResetGameData() {
+    std::filesystem::remove_all(GameDataDir());
+    std::filesystem::create_directories(GameDataDir());
+}
+
+static void MakeGame(const std::string& _name, size_t _bytes = 0) {
+    std::filesystem::create_directories(GameDataDir() + "/" + _name);
+    std::ofstream(GameDataDir() + "/" + _name + "/moves.txt") << std::string(_bytes, 'm');
+}
+
+static bool GameExists(const std::string& _name) {
+    return std::filesystem::exists(GameDataDir() + "/" + _name);
+}
+
+static void WriteManifest(const std::string& _contents) {
+    std::ofstream(GameDataDir() + "/Manifest.txt", std::ios::binary) << _contents;
+}
+
+static std::string ReadManifest() {
+    std::ifstream file(GameDataDir() + "/Manifest.txt", std::ios::binary);
+    return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+}
+
+// Trimming runs on the manifest's own thread, give it a few seconds to retire the game
+static bool WaitUntilRemoved(const std::string& _name) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (GameExists(_name)) {
+        if (std::chrono::steady_clock::now() > deadline) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return true;
+}
+
+static RetentionPolicy Policy(int _maxGames, int _maxAgeDays, uint64_t _maxBytes) {
+    RetentionPolicy policy;
+    policy.maxGames = _maxGames;
+    policy.maxAgeDays = _maxAgeDays;
+    policy.maxBytes = _maxBytes;
+    return policy;
+}
+
+/*
+ * LOADING
+ */
+
+TEST(GameDataManifestLoad) {
+    ResetGameData();
+    int64_t now = time(nullptr);
+    for (const char* name : {"Game A", "Game B", "Game C"}) MakeGame(name);
+
+    // the last line for Game A takes it to 500 bytes, over the budget on its own, malformed lines are skipped
+    WriteManifest(std::to_string(now - 30) + " 10 Game A\n" +
+                  std::to_string(now - 20) + " 10 Game B\n" +
+                  "not a manifest line\n" +
+                  std::to_string(now - 10) + " 10 Game C\n" +
+                  std::to_string(now - 30) + " 500 Game A\n");
+
+    GameDataManifest manifest;
+    CHECK(manifest.Open(GameDataDir(), Policy(100, 0, 100)));
+    CHECK(WaitUntilRemoved("Game A"));
+    manifest.Close();
+
+    CHECK(GameExists("Game B"));
+    CHECK(GameExists("Game C"));
+    CHECK_EQ(ReadManifest(), std::to_string(now - 20) + " 10 Game B\n" + std::to_string(now - 10) + " 10 Game C\n");
+
+    std::filesystem::remove_all(GameDataDir());
+}
+
+TEST(GameDataManifestRebuild) {
+    ResetGameData();
+    MakeGame("Game 1", 40);
+    MakeGame("Game 2", 2);
+
+    // without a manifest one is built from the directories that are there
+    GameDataManifest manifest;
+    CHECK(manifest.Open(GameDataDir(), Policy(10, 0, 0)));
+    manifest.Close();
+
+    std::string contents = ReadManifest();
+    CHECK(contents.find(" 40 Game 1\n") != std::string::npos);
+    CHECK(contents.find(" 2 Game 2\n") != std::string::npos);
+    CHECK(GameExists("Game 1"));
+    CHECK(GameExists("Game 2"));
+
+    std::filesystem::remove_all(GameDataDir());
+}
+
+/*
+ * TRIMMING
+ */
+
+TEST(GameDataManifestTrimCount) {
+    ResetGameData();
+    int64_t now = time(nullptr);
+    std::string lines;
+    for (int game = 0; game < 4; game++) {
+        MakeGame("Game " + std::to_string(game));
+        lines += std::to_string(now - 40 + game) + " 0 Game " + std::to_string(game) + "\n";
+    }
+    WriteManifest(lines);
+
+    GameDataManifest manifest;
+    CHECK(manifest.Open(GameDataDir(), Policy(2, 0, 0)));
+    CHECK(WaitUntilRemoved("Game 0"));
+    CHECK(WaitUntilRemoved("Game 1"));
+    manifest.Close();
+
+    CHECK(GameExists("Game 2"));
+    CHECK(GameExists("Game 3"));
+    CHECK_EQ(ReadManifest(), std::to_string(now - 38) + " 0 Game 2\n" + std::to_string(now - 37) + " 0 Game 3\n");
+
+    std::filesystem::remove_all(GameDataDir());
+}
+
+TEST(GameDataManifestTrimAge) {
+    ResetGameData();
+    int64_t now = time(nullptr);
+    for (const char* name : {"Old", "Older", "Recent", "Newest"}) MakeGame(name);
+    WriteManifest(std::to_string(now - 10 * DAY) + " 0 Older\n" +
+                  std::to_string(now - 9 * DAY) + " 0 Old\n" +
+                  std::to_string(now - DAY) + " 0 Recent\n" +
+                  std::to_string(now) + " 0 Newest\n");
+
+    GameDataManifest manifest;
+    CHECK(manifest.Open(GameDataDir(), Policy(100, 5, 0)));
+    CHECK(WaitUntilRemoved("Older"));
+    CHECK(WaitUntilRemoved("Old"));
+    manifest.Close();
+
+    CHECK(GameExists("Recent"));
+    CHECK(GameExists("Newest"));
+
+    std::filesystem::remove_all(GameDataDir());
+}
+
+TEST(GameDataManifestTrimBytes) {
+    ResetGameData();
+    int64_t now = time(nullptr);
+    std::string lines;
+    for (int game = 0; game < 4; game++) {
+        MakeGame("Game " + std::to_string(game), 100);
+        lines += std::to_string(now - 40 + game) + " 100 Game " + std::to_string(game) + "\n";
+    }
+    WriteManifest(lines);
+
+    // 400 bytes against 250 retires the oldest two
+    GameDataManifest manifest;
+    CHECK(manifest.Open(GameDataDir(), Policy(100, 0, 250)));
+    CHECK(WaitUntilRemoved("Game 0"));
+    CHECK(WaitUntilRemoved("Game 1"));
+    manifest.Close();
+
+    CHECK(GameExists("Game 2"));
+    CHECK(GameExists("Game 3"));
+
+    std::filesystem::remove_all(GameDataDir());
+}
+
+TEST(GameDataManifestKeepsNewest) {
+    ResetGameData();
+    int64_t now = time(nullptr);
+    MakeGame("Previous", 1000);
+    MakeGame("Current", 1000);
+    WriteManifest(std::to_string(now - 20 * DAY) + " 1000 Previous\n" +
+                  std::to_string(now - 10 * DAY) + " 1000 Current\n");
+
+    // the newest game breaks every limit on its own and is still kept
+    GameDataManifest manifest;
+    CHECK(manifest.Open(GameDataDir(), Policy(1, 1, 10)));
+    CHECK(WaitUntilRemoved("Previous"));
+    manifest.Close();
+
+    CHECK(GameExists("Current"));
+    CHECK_EQ(ReadManifest(), std::to_string(now - 10 * DAY) + " 1000 Current\n");
+
+    std::filesystem::remove_all(GameDataDir());
+}
+
+TEST(GameDataManifestAddGame) {
+    ResetGameData();
+    int64_t now = time(nullptr);
+    MakeGame("First");
+    MakeGame("Second");
+    WriteManifest(std::to_string(now - 20) + " 0 First\n" + std::to_string(now - 10) + " 0 Second\n");
+
+    GameDataManifest manifest;
+    CHECK(manifest.Open(GameDataDir(), Policy(2, 0, 0)));
+
+    // adding a third game goes over the count and retires the first
+    MakeGame("Third Game");
+    CHECK(manifest.AddGame(GameDataDir() + "/Third Game"));
+    CHECK(!manifest.AddGame(GameDataDir() + "/Third Game"));
+    CHECK(WaitUntilRemoved("First"));
+
+    // a size update is appended, so it is the last line for the game and replaces its size on the next load
+    MakeGame("Third Game", 64);
+    manifest.UpdateGameSize(GameDataDir() + "/Third Game");
+    manifest.Close();
+
+    CHECK(GameExists("Second"));
+    CHECK(GameExists("Third Game"));
+    std::string contents = ReadManifest();
+    CHECK(contents.find(" 0 Second\n") != std::string::npos);
+    std::string lastLine = " 64 Third Game\n";
+    CHECK(contents.size() > lastLine.size() && contents.substr(contents.size() - lastLine.size()) == lastLine);
+    CHECK(!manifest.AddGame(GameDataDir() + "/Fourth Game"));
+
+    std::filesystem::remove_all(GameDataDir());
+}
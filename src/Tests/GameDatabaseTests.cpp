@@ -0,0 +1,266 @@
+//
+// Created by cew05 on 19/10/2026.
+//
+
+#include "TestRunner.h"
+#include "../Gameplay/include/GameDatabase.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+
+static const std::string START_FEN = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+static std::string DatabaseDir() {
+    return (std::filesystem::temp_directory_path() / "chess_gamedatabase_test").string();
+}
+
+static std::vector<Move16> ParseMoves(const std::vector<const char*>& _ucis) {
+    Position position;
+    position.FromFEN(START_FEN);
+
+    std::vector<Move16> moves;
+    for (const char* uci : _ucis) {
+        moves.push_back(position.ParseUCI(uci));
+        position.Apply(moves.back());
+    }
+    return moves;
+}
+
+static Position PositionAfter(const std::vector<const char*>& _ucis) {
+    Position position;
+    position.FromFEN(START_FEN);
+    for (Move16 move : ParseMoves(_ucis)) position.Apply(move);
+    return position;
+}
+
+static const MoveStatistic* FindStatistic(const std::vector<MoveStatistic>& _statistics, Move16 _move) {
+    for (const MoveStatistic& statistic : _statistics) {
+        if (statistic.move == _move) return &statistic;
+    }
+    return nullptr;
+}
+
+static size_t RunFilesOnDisk(const std::string& _directory) {
+    size_t count = 0;
+    for (const auto& dirEntry : std::filesystem::directory_iterator(_directory)) {
+        if (dirEntry.path().extension() == ".cpi") count++;
+    }
+    return count;
+}
+
+/*
+ * ADDING / QUERIES
+ */
+
+TEST(GameDatabaseQueries) {
+    std::filesystem::remove_all(DatabaseDir());
+
+    GameDatabase database;
+    CHECK(database.Open(DatabaseDir()));
+    CHECK(database.AddGame(START_FEN, ParseMoves({"e2e4", "e7e5", "g1f3"}), GameResult::WHITE_WIN, "Event=One\n", 7));
+    CHECK(database.AddGame(START_FEN, ParseMoves({"e2e4", "c7c5"}), GameResult::DRAW));
+    CHECK(database.AddGame(START_FEN, ParseMoves({"d2d4", "d7d5"}), GameResult::BLACK_WIN));
+    CHECK(!database.AddGame("not a fen", {}, GameResult::DRAW));
+
+    // nothing is searchable until the commit
+    Position start = PositionAfter({});
+    CHECK_EQ(database.CountGames(start), (uint64_t)0);
+    CHECK(database.Commit());
+    CHECK_EQ(database.GameCount(), (uint32_t)3);
+    CHECK_EQ(database.CountGames(start), (uint64_t)3);
+
+    Position afterE4 = PositionAfter({"e2e4"});
+    CHECK_EQ(database.CountGames(afterE4), (uint64_t)2);
+    CHECK_EQ(database.CountGames(PositionAfter({"g1f3"})), (uint64_t)0);
+
+    std::vector<PositionHit> hits;
+    database.FindGames(afterE4, hits);
+    CHECK_EQ(hits.size(), (size_t)2);
+    if (hits.size() == 2) {
+        CHECK_EQ(hits[0].gameID, (uint32_t)0);
+        CHECK_EQ(hits[0].ply, 1);
+        CHECK_EQ(hits[1].gameID, (uint32_t)1);
+    }
+    database.FindGames(afterE4, hits, 1);
+    CHECK_EQ(hits.size(), (size_t)1);
+
+    // scored for the side to move, white from the start and black after 1.e4
+    std::vector<MoveStatistic> statistics;
+    database.FetchMoveStatistics(start, statistics);
+    CHECK_EQ(statistics.size(), (size_t)2);
+    if (const MoveStatistic* e4 = FindStatistic(statistics, start.ParseUCI("e2e4"))) {
+        CHECK_EQ(e4->games, (uint32_t)2);
+        CHECK_EQ(e4->wins, (uint32_t)1);
+        CHECK_EQ(e4->draws, (uint32_t)1);
+        CHECK_EQ(e4->losses, (uint32_t)0);
+        CHECK_EQ(e4->Score(), 0.75f);
+    } else _failed = true;
+    if (const MoveStatistic* d4 = FindStatistic(statistics, start.ParseUCI("d2d4"))) {
+        CHECK_EQ(d4->losses, (uint32_t)1);
+    } else _failed = true;
+    CHECK(statistics[0].games >= statistics[1].games);
+
+    database.FetchMoveStatistics(afterE4, statistics);
+    if (const MoveStatistic* e5 = FindStatistic(statistics, afterE4.ParseUCI("e7e5"))) {
+        CHECK_EQ(e5->losses, (uint32_t)1);
+        CHECK_EQ(e5->wins, (uint32_t)0);
+    } else _failed = true;
+
+    // the final position has no move to count
+    database.FetchMoveStatistics(PositionAfter({"e2e4", "c7c5"}), statistics);
+    CHECK(statistics.empty());
+
+    StoredGame game;
+    CHECK(database.FetchGame(0, game));
+    CHECK_EQ(game.startFEN, START_FEN);
+    CHECK_EQ(game.metadata, std::string("Event=One\n"));
+    CHECK(game.moves == ParseMoves({"e2e4", "e7e5", "g1f3"}));
+    CHECK(game.result == GameResult::WHITE_WIN);
+    CHECK_EQ(game.startTime, (int64_t)7);
+    CHECK(!database.FetchGame(3, game));
+
+    database.Close();
+    std::filesystem::remove_all(DatabaseDir());
+}
+
+/*
+ * RUNS
+ */
+
+TEST(GameDatabaseRunMerge) {
+    std::filesystem::remove_all(DatabaseDir());
+    std::vector<Move16> moves = ParseMoves({"e2e4", "e7e5", "g1f3", "b8c6"});
+
+    GameDatabase database;
+    CHECK(database.Open(DatabaseDir()));
+
+    // a run of four games followed by a run of one stays as two, less than half its size
+    for (int game = 0; game < 4; game++) CHECK(database.AddGame(START_FEN, moves, GameResult::DRAW));
+    CHECK(database.Commit());
+    CHECK(database.AddGame(START_FEN, moves, GameResult::DRAW));
+    CHECK(database.Commit());
+    CHECK_EQ(database.RunCount(), (size_t)2);
+    CHECK_EQ(RunFilesOnDisk(DatabaseDir()), (size_t)2);
+    CHECK_EQ(database.CountGames(PositionAfter({"e2e4"})), (uint64_t)5);
+
+    // a second single game brings the newest run up to half, it merges and leaves one run covering every game
+    CHECK(database.AddGame(START_FEN, moves, GameResult::WHITE_WIN));
+    CHECK(database.Commit());
+    CHECK_EQ(database.RunCount(), (size_t)1);
+    CHECK_EQ(RunFilesOnDisk(DatabaseDir()), (size_t)1);
+    CHECK(std::filesystem::exists(DatabaseDir() + "/Positions-0-6.cpi"));
+
+    std::vector<PositionHit> hits;
+    database.FindGames(PositionAfter({"e2e4", "e7e5"}), hits);
+    CHECK_EQ(hits.size(), (size_t)6);
+    for (size_t hit = 0; hit < hits.size(); hit++) CHECK_EQ(hits[hit].gameID, (uint32_t)hit);
+
+    // committing with nothing pending writes nothing
+    CHECK(database.Commit());
+    CHECK_EQ(RunFilesOnDisk(DatabaseDir()), (size_t)1);
+
+    database.Close();
+
+    // reopening finds the same games through the merged run
+    CHECK(database.Open(DatabaseDir()));
+    CHECK_EQ(database.GameCount(), (uint32_t)6);
+    CHECK_EQ(database.RunCount(), (size_t)1);
+    CHECK_EQ(database.CountGames(PositionAfter({"e2e4", "e7e5", "g1f3"})), (uint64_t)6);
+
+    database.Close();
+    std::filesystem::remove_all(DatabaseDir());
+}
+
+TEST(GameDatabaseReindex) {
+    std::filesystem::remove_all(DatabaseDir());
+
+    {
+        GameDatabase database;
+        CHECK(database.Open(DatabaseDir()));
+        CHECK(database.AddGame(START_FEN, ParseMoves({"e2e4", "e7e5"}), GameResult::WHITE_WIN));
+        CHECK(database.AddGame(START_FEN, ParseMoves({"d2d4"}), GameResult::DRAW));
+    }
+
+    // games without a run, as a crash between writing games and their run leaves them, are indexed on open
+    for (const auto& dirEntry : std::filesystem::directory_iterator(DatabaseDir())) {
+        if (dirEntry.path().extension() == ".cpi") std::filesystem::remove(dirEntry.path());
+    }
+    std::filesystem::path leftover = std::filesystem::path(DatabaseDir()) / "Positions-0-9.cpi.tmp";
+    fclose(fopen(leftover.string().c_str(), "wb"));
+
+    GameDatabase database;
+    CHECK(database.Open(DatabaseDir()));
+    CHECK_EQ(database.GameCount(), (uint32_t)2);
+    CHECK_EQ(database.RunCount(), (size_t)1);
+    CHECK_EQ(database.CountGames(PositionAfter({})), (uint64_t)2);
+    CHECK_EQ(database.CountGames(PositionAfter({"e2e4", "e7e5"})), (uint64_t)1);
+    CHECK(!std::filesystem::exists(leftover));
+
+    database.Close();
+    std::filesystem::remove_all(DatabaseDir());
+}
+
+/*
+ * DAMAGED FILES
+ */
+
+TEST(GameDatabaseDamagedTail) {
+    std::filesystem::remove_all(DatabaseDir());
+    std::string gamesPath = DatabaseDir() + "/Games.cgd";
+
+    {
+        GameDatabase database;
+        CHECK(database.Open(DatabaseDir()));
+        CHECK(database.AddGame(START_FEN, ParseMoves({"e2e4"}), GameResult::DRAW));
+        CHECK(database.AddGame(START_FEN, ParseMoves({"d2d4"}), GameResult::DRAW));
+    }
+    uint64_t goodSize = std::filesystem::file_size(gamesPath);
+
+    StoredGame secondGame;
+    {
+        GameDatabase database;
+        CHECK(database.Open(DatabaseDir()));
+        CHECK(database.FetchGame(1, secondGame));
+    }
+
+    // the start of a third game, its header promising more than was written
+    {
+        std::vector<char> bytes(sizeof(GameEntryHeader) + 8);
+        FILE* file = fopen(gamesPath.c_str(), "rb");
+        CHECK(fread(bytes.data(), 1, bytes.size(), file) == bytes.size());
+        fclose(file);
+        file = fopen(gamesPath.c_str(), "ab");
+        fwrite(bytes.data(), 1, bytes.size(), file);
+        fclose(file);
+    }
+
+    // read only, the damaged game is skipped but the file is left alone and nothing can be added
+    {
+        GameDatabase database;
+        CHECK(database.Open(DatabaseDir(), true));
+        CHECK_EQ(database.GameCount(), (uint32_t)2);
+        CHECK_EQ(database.CountGames(PositionAfter({})), (uint64_t)2);
+        CHECK(!database.AddGame(START_FEN, ParseMoves({"c2c4"}), GameResult::DRAW));
+        CHECK(database.Commit());
+    }
+    CHECK_EQ(std::filesystem::file_size(gamesPath), goodSize + sizeof(GameEntryHeader) + 8);
+
+    // opened to write, the damaged game is cut off and new games follow the good ones
+    GameDatabase database;
+    CHECK(database.Open(DatabaseDir()));
+    CHECK_EQ(database.GameCount(), (uint32_t)2);
+    CHECK_EQ(std::filesystem::file_size(gamesPath), goodSize);
+
+    CHECK(database.AddGame(START_FEN, ParseMoves({"c2c4"}), GameResult::BLACK_WIN));
+    CHECK(database.Commit());
+    StoredGame game;
+    CHECK(database.FetchGame(1, game));
+    CHECK(game.moves == secondGame.moves);
+    CHECK(database.FetchGame(2, game));
+    CHECK(game.result == GameResult::BLACK_WIN);
+    CHECK_EQ(database.CountGames(PositionAfter({})), (uint64_t)3);
+
+    database.Close();
+    std::filesystem::remove_all(DatabaseDir());
+}
@@ -0,0 +1,157 @@
+//
+// Created by cew05 on 19/10/2026.
+//
+
+#include "TestRunner.h"
+#include "../Gameplay/include/GameRecord.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+static const std::string START_FEN = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+// En passant on ply 5, a capturing promotion on ply 9 and white castling on ply 15
+static const char* GAME_MOVES[] = {
+        "e2e4", "g8f6", "e4e5", "d7d5", "e5d6", "c7c6", "d6e7", "b8d7", "e7d8q", "e8d8",
+        "g1f3", "h7h6", "f1c4", "h6h5", "e1g1", "h5h4", "d2d4",
+};
+static const int GAME_PLIES = sizeof(GAME_MOVES) / sizeof(GAME_MOVES[0]);
+
+static std::string RecordPath(const char* _name) {
+    return (std::filesystem::temp_directory_path() / _name).string();
+}
+
+static bool SaveGame(const std::string& _path, int _keyframeInterval, GameRecord& _record) {
+    _record.SetKeyframeInterval(_keyframeInterval);
+    if (!_record.Begin(START_FEN, 1760000000)) return false;
+    _record.AddMetadata("White", "Player One");
+    _record.AddMetadata("Black", "Stockfish");
+    for (const char* uci : GAME_MOVES) {
+        if (!_record.AddMove(uci)) return false;
+    }
+    _record.SetResult(GameResult::WHITE_WIN);
+    return _record.Save(_path);
+}
+
+/*
+ * SAVE / OPEN
+ */
+
+TEST(GameRecordRoundTrip) {
+    std::string path = RecordPath("chess_gamerecord_test.cgr");
+    GameRecord record;
+    CHECK(SaveGame(path, 4, record));
+    CHECK(!std::filesystem::exists(path + ".tmp"));
+
+    GameRecordReader reader;
+    CHECK(reader.Open(path));
+    CHECK_EQ(reader.PlyCount(), GAME_PLIES);
+    CHECK_EQ(reader.KeyframeInterval(), 4);
+    CHECK(reader.Result() == GameResult::WHITE_WIN);
+    CHECK_EQ(reader.StartTime(), (int64_t)1760000000);
+    CHECK_EQ(reader.StartFEN(), START_FEN);
+    CHECK_EQ(reader.Metadata(), std::string("White=Player One\nBlack=Stockfish\n"));
+
+    for (int ply = 0; ply < GAME_PLIES; ply++) CHECK_EQ(reader.MoveAt(ply), record.Moves()[ply]);
+    CHECK_EQ(reader.MoveAt(-1), Position::MOVE_NONE);
+    CHECK_EQ(reader.MoveAt(GAME_PLIES), Position::MOVE_NONE);
+
+    reader.Close();
+    std::filesystem::remove(path);
+}
+
+TEST(GameRecordLayout) {
+    std::string path = RecordPath("chess_gamerecord_layout.cgr");
+    GameRecord record;
+    CHECK(SaveGame(path, 4, record));
+
+    std::ifstream file(path, std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    file.close();
+    CHECK(bytes.size() >= sizeof(GameRecordHeader));
+    if (bytes.size() < sizeof(GameRecordHeader)) return;
+
+    GameRecordHeader header {};
+    memcpy(&header, bytes.data(), sizeof(header));
+    CHECK(memcmp(header.magic, "CGRC", 4) == 0);
+    CHECK_EQ(header.version, (uint16_t)1);
+    CHECK_EQ(header.plyCount, (uint32_t)GAME_PLIES);
+    CHECK_EQ(header.keyframeCount, (uint32_t)(GAME_PLIES / 4 + 1));
+
+    // sections follow each other in order, keyframes aligned and ending the file
+    CHECK_EQ(header.fenOffset, (uint32_t)sizeof(GameRecordHeader));
+    CHECK_EQ(header.fenLength, (uint32_t)START_FEN.size());
+    CHECK_EQ(header.metaOffset, header.fenOffset + header.fenLength);
+    CHECK_EQ(header.movesOffset, header.metaOffset + header.metaLength);
+    CHECK(header.keyframesOffset >= header.movesOffset + header.plyCount * sizeof(Move16));
+    CHECK_EQ(header.keyframesOffset % 8, (uint32_t)0);
+    CHECK_EQ((uint64_t)bytes.size(), header.keyframesOffset + header.keyframeCount * sizeof(PackedPosition));
+    CHECK_EQ(bytes.substr(header.fenOffset, header.fenLength), START_FEN);
+
+    std::filesystem::remove(path);
+}
+
+/*
+ * SEEKING
+ */
+
+TEST(GameRecordSeekPly) {
+    std::string path = RecordPath("chess_gamerecord_seek.cgr");
+
+    // an interval of 4 puts keyframes at 0, 4, 8, 12 and 16, so plies on and between keyframes are both seeked
+    for (int interval : {1, 4, 5, 64}) {
+        GameRecord record;
+        CHECK(SaveGame(path, interval, record));
+
+        GameRecordReader reader;
+        CHECK(reader.Open(path));
+
+        Position replay;
+        CHECK(replay.FromFEN(START_FEN));
+        for (int ply = 0; ply <= GAME_PLIES; ply++) {
+            Position seeked;
+            CHECK(reader.SeekPly(ply, seeked));
+            if (seeked.ToFEN() != replay.ToFEN() || seeked.Key() != replay.Key()) {
+                printf("  interval %d ply %d: %s != %s\n", interval, ply, seeked.ToFEN().c_str(),
+                       replay.ToFEN().c_str());
+                _failed = true;
+            }
+            if (ply < GAME_PLIES) replay.Apply(reader.MoveAt(ply));
+        }
+
+        Position unused;
+        CHECK(!reader.SeekPly(-1, unused));
+        CHECK(!reader.SeekPly(GAME_PLIES + 1, unused));
+    }
+
+    std::filesystem::remove(path);
+}
+
+/*
+ * DAMAGED FILES
+ */
+
+TEST(GameRecordRejectsTruncated) {
+    std::string path = RecordPath("chess_gamerecord_full.cgr");
+    std::string truncatedPath = RecordPath("chess_gamerecord_truncated.cgr");
+    GameRecord record;
+    CHECK(SaveGame(path, 4, record));
+    uint64_t size = std::filesystem::file_size(path);
+
+    // cut into the last keyframe, into the moves and into the header
+    for (uint64_t keep : {size - 1, size - sizeof(PackedPosition) * 3, (uint64_t)sizeof(GameRecordHeader) + 10,
+                          (uint64_t)sizeof(GameRecordHeader) - 1}) {
+        std::filesystem::copy_file(path, truncatedPath, std::filesystem::copy_options::overwrite_existing);
+        std::filesystem::resize_file(truncatedPath, keep);
+
+        GameRecordReader reader;
+        CHECK(!reader.Open(truncatedPath));
+        CHECK(!reader.IsOpen());
+        CHECK_EQ(reader.MoveAt(0), Position::MOVE_NONE);
+    }
+
+    std::filesystem::remove(truncatedPath);
+    std::filesystem::remove(path);
+}
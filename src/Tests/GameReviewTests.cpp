@@ -0,0 +1,153 @@
+//
+// Created by cew05 on 19/10/2026.
+//
+
+#include "TestRunner.h"
+#include "../Gameplay/include/GameReview.h"
+
+struct ReviewGame {
+    const char* startFEN;
+    std::vector<const char*> moves;
+};
+
+static const ReviewGame REVIEW_GAMES[] = {
+        // white en passant, a capturing promotion and white castling short
+        {"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+         {"e2e4", "g8f6", "e4e5", "d7d5", "e5d6", "c7c6", "d6e7", "b8d7", "e7d8q", "e8d8",
+          "g1f3", "h7h6", "f1c4", "h6h5", "e1g1", "h5h4", "d2d4"}},
+        // black en passant, white castling long, black castling short and a knight underpromotion
+        {"r3k2r/8/8/8/1p6/8/P6P/R3K2R w KQkq - 0 1",
+         {"a2a4", "b4a3", "e1c1", "e8g8", "h2h4", "a3a2", "h4h5", "a2a1n", "d1d8", "f8d8"}},
+};
+
+static std::vector<Move16> ParseMoves(const ReviewGame& _game) {
+    Position position;
+    position.FromFEN(_game.startFEN);
+
+    std::vector<Move16> moves;
+    for (const char* uci : _game.moves) {
+        moves.push_back(position.ParseUCI(uci));
+        position.Apply(moves.back());
+    }
+    return moves;
+}
+
+// Every position of the game by applying each move in turn
+static std::vector<Position> Replay(const ReviewGame& _game) {
+    std::vector<Position> positions(1);
+    positions[0].FromFEN(_game.startFEN);
+    for (Move16 move : ParseMoves(_game)) {
+        positions.push_back(positions.back());
+        positions.back().Apply(move);
+    }
+    return positions;
+}
+
+static bool MatchesReplay(const GameReview& _review, const std::vector<Position>& _replay) {
+    const Position& expected = _replay[_review.Ply()];
+    const Position& actual = _review.CurrentPosition();
+    if (actual.ToFEN() == expected.ToFEN() && actual.Key() == expected.Key()) return true;
+
+    printf("  ply %d: %s != %s\n", _review.Ply(), actual.ToFEN().c_str(), expected.ToFEN().c_str());
+    return false;
+}
+
+/*
+ * STEPPING
+ */
+
+TEST(GameReviewStepForward) {
+    for (const ReviewGame& game : REVIEW_GAMES) {
+        std::vector<Move16> moves = ParseMoves(game);
+        std::vector<Position> replay = Replay(game);
+
+        GameReview review;
+        review.SetKeyframeInterval(4);
+        CHECK(review.Load(game.startFEN, moves, GameResult::DRAW));
+        CHECK_EQ(review.Ply(), 0);
+        CHECK_EQ(review.LastMove(), Position::MOVE_NONE);
+        CHECK(MatchesReplay(review, replay));
+
+        while (review.StepForward()) {
+            CHECK(MatchesReplay(review, replay));
+            CHECK_EQ(review.LastMove(), moves[review.Ply() - 1]);
+        }
+        CHECK_EQ(review.Ply(), review.PlyCount());
+        CHECK_EQ(review.PlyCount(), (int)moves.size());
+    }
+}
+
+TEST(GameReviewStepBack) {
+    for (const ReviewGame& game : REVIEW_GAMES) {
+        std::vector<Position> replay = Replay(game);
+
+        GameReview review;
+        review.SetKeyframeInterval(4);
+        CHECK(review.Load(game.startFEN, ParseMoves(game), GameResult::DRAW));
+
+        // stepped forward from the start, every step back has its undo state
+        while (review.StepForward()) {}
+        while (review.StepBack()) CHECK(MatchesReplay(review, replay));
+        CHECK_EQ(review.Ply(), 0);
+
+        // seeked to the end the run starts from the last keyframe, stepping back past it goes through earlier ones
+        CHECK(review.SeekPly(review.PlyCount()));
+        CHECK(MatchesReplay(review, replay));
+        while (review.StepBack()) CHECK(MatchesReplay(review, replay));
+        CHECK_EQ(review.Ply(), 0);
+        CHECK(!review.StepBack());
+
+        // and forward again from wherever the steps back left the undo states
+        CHECK(review.SeekPly(6));
+        CHECK(review.StepBack());
+        CHECK(review.StepForward());
+        CHECK(review.StepForward());
+        CHECK(MatchesReplay(review, replay));
+    }
+}
+
+/*
+ * SEEKING
+ */
+
+TEST(GameReviewSeekPly) {
+    for (const ReviewGame& game : REVIEW_GAMES) {
+        std::vector<Position> replay = Replay(game);
+
+        for (int interval : {1, 3, 4, 64}) {
+            GameReview review;
+            review.SetKeyframeInterval(interval);
+            CHECK(review.Load(game.startFEN, ParseMoves(game), GameResult::DRAW));
+
+            // every ply from every other, covering stepped seeks and seeks through keyframes both ways
+            for (int from = 0; from <= review.PlyCount(); from++) {
+                for (int to = 0; to <= review.PlyCount(); to++) {
+                    review.SeekPly(from);
+                    CHECK_EQ(review.SeekPly(to), from != to);
+                    CHECK_EQ(review.Ply(), to);
+                    if (!MatchesReplay(review, replay)) {
+                        printf("  interval %d seeking %d from %d\n", interval, to, from);
+                        _failed = true;
+                    }
+                }
+            }
+
+            // out of range seeks stop at either end of the game
+            review.SeekPly(-5);
+            CHECK_EQ(review.Ply(), 0);
+            review.SeekPly(review.PlyCount() + 5);
+            CHECK_EQ(review.Ply(), review.PlyCount());
+            CHECK(MatchesReplay(review, replay));
+        }
+    }
+}
+
+TEST(GameReviewUnloaded) {
+    GameReview review;
+    CHECK(!review.IsLoaded());
+    CHECK(!review.StepForward());
+    CHECK(!review.StepBack());
+    CHECK(!review.SeekPly(3));
+    CHECK(!review.Load("not a fen", {}, GameResult::DRAW));
+    CHECK(!review.IsLoaded());
+}
@@ -0,0 +1,48 @@
+//
+// Created by cew05 on 19/10/2026.
+//
+
+#include "TestRunner.h"
+#include "../src_headers/MappedFile.h"
+
+#include <cstring>
+#include <filesystem>
+
+TEST(MappedFileReadWrite) {
+    std::string path = (std::filesystem::temp_directory_path() / "chess_mappedfile_test.bin").string();
+    std::filesystem::remove(path);
+
+    // new files are created at the requested size, zeroed
+    {
+        MappedFile mapped;
+        CHECK(mapped.OpenReadWrite(path, 4096));
+        CHECK_EQ(mapped.Size(), (uint64_t)4096);
+        CHECK_EQ(mapped.Data()[100], 0);
+        memcpy(mapped.MutableData(), "chess", 5);
+        CHECK(mapped.Flush());
+    }
+
+    // read only views see the write and cannot be written through
+    {
+        MappedFile mapped;
+        CHECK(mapped.OpenRead(path));
+        CHECK_EQ(mapped.Size(), (uint64_t)4096);
+        CHECK(memcmp(mapped.Data(), "chess", 5) == 0);
+        CHECK(mapped.MutableData() == nullptr);
+    }
+
+    // a smaller requested size keeps the file as it is
+    {
+        MappedFile mapped;
+        CHECK(mapped.OpenReadWrite(path, 16));
+        CHECK_EQ(mapped.Size(), (uint64_t)4096);
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST(MappedFileMissing) {
+    MappedFile mapped;
+    CHECK(!mapped.OpenRead((std::filesystem::temp_directory_path() / "chess_mappedfile_missing.bin").string()));
+    CHECK(!mapped.IsOpen());
+}
@@ -0,0 +1,95 @@
+//
+// Created by cew05 on 19/10/2026.
+//
+
+#include "TestRunner.h"
+#include "../Gameplay/include/Position.h"
+#include "../Gameplay/include/PGN.h"
+
+// White pawns on b7 and e7, either can promote, e8 gives check along the back rank
+static const std::string PROMOTION_FEN = "1nb4k/1P2P3/8/8/8/8/8/4K3 w - - 0 1";
+
+/*
+ * SAN
+ */
+
+TEST(SANPromotionForms) {
+    Position position;
+    CHECK(position.FromFEN(PROMOTION_FEN));
+
+    Move16 queen = position.ParseUCI("e7e8q");
+    CHECK(queen != Position::MOVE_NONE);
+    CHECK_EQ(position.ParseSAN("e8=Q"), queen);
+    CHECK_EQ(position.ParseSAN("e8=Q+"), queen);
+    CHECK_EQ(position.ParseSAN("e8Q"), queen);
+    CHECK_EQ(position.ParseSAN("e8Q+"), queen);
+
+    Move16 knight = position.ParseUCI("b7c8n");
+    CHECK(knight != Position::MOVE_NONE);
+    CHECK_EQ(position.ParseSAN("bxc8=N"), knight);
+    CHECK_EQ(position.ParseSAN("bxc8N"), knight);
+
+    // a promotion has to name its piece, and only pawns on the last rank promote
+    CHECK_EQ(position.ParseSAN("e8"), Position::MOVE_NONE);
+    CHECK_EQ(position.ParseSAN("Ke2=Q"), Position::MOVE_NONE);
+}
+
+TEST(SANRoundTrip) {
+    const char* fens[] = {
+            "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+            "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+            "rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3",
+            "1nb4k/1P2P3/8/8/8/8/8/4K3 w - - 0 1",
+            "4k3/8/8/8/8/8/1p2p3/R3K1N1 b Q - 0 1",
+            "4k3/8/8/8/8/1N3N2/8/1N2K1N1 w - - 0 1",
+    };
+
+    for (const char* fen : fens) {
+        Position position;
+        CHECK(position.FromFEN(fen));
+
+        std::vector<Move16> moves;
+        position.GenerateLegalMoves(moves);
+        CHECK(!moves.empty());
+
+        for (Move16 move : moves) {
+            std::string san = position.ToSAN(move);
+            if (position.ParseSAN(san) != move) {
+                printf("  %s: %s did not parse back\n", fen, san.c_str());
+                _failed = true;
+            }
+        }
+    }
+}
+
+/*
+ * PGN
+ */
+
+TEST(PGNPromotionRoundTrip) {
+    PgnGame game;
+    game.startFEN = PROMOTION_FEN;
+    game.tags.emplace_back("FEN", PROMOTION_FEN);
+    game.tags.emplace_back("SetUp", "1");
+    game.result = GameResult::WHITE_WIN;
+
+    Position position;
+    CHECK(position.FromFEN(PROMOTION_FEN));
+    for (const char* uci : {"e7e8q", "h8h7", "b7c8n"}) {
+        Move16 move = position.ParseUCI(uci);
+        CHECK(move != Position::MOVE_NONE);
+        game.moves.push_back(move);
+        position.Apply(move);
+    }
+
+    std::string pgn = PgnWriter::FormatGame(game);
+    CHECK(pgn.find("e8=Q+") != std::string::npos);
+    CHECK(pgn.find("bxc8=N") != std::string::npos);
+
+    PgnGame parsed;
+    const char* cursor = pgn.data();
+    CHECK(PgnReader::ParseGame(cursor, pgn.data() + pgn.size(), parsed));
+    CHECK_EQ(parsed.startFEN, game.startFEN);
+    CHECK(parsed.moves == game.moves);
+    CHECK(parsed.result == GameResult::WHITE_WIN);
+}
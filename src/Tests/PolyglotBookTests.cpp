@@ -0,0 +1,121 @@
+//
+// Created by cew05 on 19/10/2026.
+//
+
+#include "TestRunner.h"
+#include "../StockfishUtil/PolyglotBook.h"
+
+#include <filesystem>
+#include <fstream>
+
+static const std::string START_FEN = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+// Index of a piece in the Random64 table, kinds ordered black pawn, white pawn ... black king, white king
+static int PieceIndex(int _kind, char _file, char _rank) {
+    return 64 * _kind + 8 * (_rank - '1') + (_file - 'a');
+}
+
+// Distinct stand in values, the layout of the key can be checked without the real table
+static uint64_t SyntheticValue(int _index) {
+    uint64_t value = (uint64_t)_index * 0x9E3779B97F4A7C15ull + 0x632BE59BD9B4E019ull;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    return value ^ (value >> 31);
+}
+
+static std::string WriteSyntheticTable(int _count) {
+    std::string path = (std::filesystem::temp_directory_path() / "chess_polyglot_random64.bin").string();
+    std::ofstream file(path, std::ios::binary);
+    for (int index = 0; index < _count; index++) {
+        uint64_t value = SyntheticValue(index);
+        for (int shift = 56; shift >= 0; shift -= 8) file.put(char((value >> shift) & 0xFF));
+    }
+    return path;
+}
+
+/*
+ * KEY LAYOUT
+ */
+
+TEST(PolyglotKeyLayout) {
+    std::string path = WriteSyntheticTable(781);
+    PolyglotBook book;
+    CHECK(book.LoadKeys(path));
+
+    // every piece of the start position, all four castling rights and white to move
+    uint64_t expected = SyntheticValue(768) ^ SyntheticValue(769) ^ SyntheticValue(770) ^ SyntheticValue(771) ^
+                        SyntheticValue(780);
+    const char* backRank = "RNBQKBNR";
+    const std::string kinds = "pPnNbBrRqQkK";
+    for (char file = 'a'; file <= 'h'; file++) {
+        char white = backRank[file - 'a'];
+        char black = char(tolower(white));
+        expected ^= SyntheticValue(PieceIndex((int)kinds.find(white), file, '1'));
+        expected ^= SyntheticValue(PieceIndex((int)kinds.find('P'), file, '2'));
+        expected ^= SyntheticValue(PieceIndex((int)kinds.find('p'), file, '7'));
+        expected ^= SyntheticValue(PieceIndex((int)kinds.find(black), file, '8'));
+    }
+    uint64_t start = book.CreateKey(START_FEN);
+    CHECK_EQ(start, expected);
+
+    // side to move and castling rights each toggle their own value
+    CHECK_EQ(start ^ book.CreateKey("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR b KQkq - 0 1"), SyntheticValue(780));
+    CHECK_EQ(start ^ book.CreateKey("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w Qkq - 0 1"), SyntheticValue(768));
+    CHECK_EQ(start ^ book.CreateKey("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQk - 0 1"), SyntheticValue(771));
+
+    // en passant only counts when a pawn of the side to move can take
+    uint64_t afterE4 = book.CreateKey("rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1");
+    CHECK_EQ(afterE4, book.CreateKey("rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq - 0 1"));
+    CHECK_EQ(start ^ afterE4, SyntheticValue(PieceIndex(1, 'e', '2')) ^ SyntheticValue(PieceIndex(1, 'e', '4')) ^
+                              SyntheticValue(780));
+    CHECK_EQ(book.CreateKey("rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3") ^
+             book.CreateKey("rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq - 0 3"), SyntheticValue(772 + 5));
+
+    std::filesystem::remove(path);
+}
+
+TEST(PolyglotRejectsShortTable) {
+    std::string path = WriteSyntheticTable(780);
+    PolyglotBook book;
+    CHECK(!book.LoadKeys(path));
+    CHECK_EQ(book.CreateKey(START_FEN), (uint64_t)0);
+    CHECK(!book.LoadKeys(path + ".missing"));
+
+    std::filesystem::remove(path);
+}
+
+/*
+ * PUBLISHED KEYS
+ */
+
+TEST(PolyglotPublishedKeys) {
+    // The key table is not shipped, these are only checked when it has been put in place
+    std::string path = std::string(CHESS_SOURCE_DIR) + "/RequiredFiles/Book/Random64.bin";
+    if (!std::filesystem::exists(path)) {
+        printf("  no Random64 table at %s, published keys not checked\n", path.c_str());
+        return;
+    }
+
+    PolyglotBook book;
+    CHECK(book.LoadKeys(path));
+
+    // The test positions of the Polyglot book format description
+    const std::pair<const char*, uint64_t> keys[] = {
+            {"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 0x463b96181691fc9cull},
+            {"rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1", 0x823c9b50fd114196ull},
+            {"rnbqkbnr/ppp1pppp/8/3p4/4P3/8/PPPP1PPP/RNBQKBNR w KQkq d6 0 2", 0x0756b94461c50fb0ull},
+            {"rnbqkbnr/ppp1pppp/8/3pP3/8/8/PPPP1PPP/RNBQKBNR b KQkq - 0 2", 0x662fafb965db29d4ull},
+            {"rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3", 0x22a48b5a8e47ff78ull},
+            {"rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPPKPPP/RNBQ1BNR b kq - 0 3", 0x652a607ca3f242c1ull},
+            {"rnbq1bnr/ppp1pkpp/8/3pPp2/8/8/PPPPKPPP/RNBQ1BNR w - - 0 4", 0x00fdd303c946bdd9ull},
+            {"rnbqkbnr/p1pppppp/8/8/PpP4P/8/1P1PPPP1/RNBQKBNR b KQkq c3 0 3", 0x3c8123ea7b067637ull},
+            {"rnbqkbnr/p1pppppp/8/8/P6P/R1p5/1P1PPPP1/1NBQKBNR b Kkq - 0 4", 0x5c3f9b829b279560ull},
+    };
+    for (const auto& [fen, key] : keys) {
+        if (book.CreateKey(fen) != key) {
+            printf("  %s: %016llx, expected %016llx\n", fen, (unsigned long long)book.CreateKey(fen),
+                   (unsigned long long)key);
+            _failed = true;
+        }
+    }
+}
@@ -0,0 +1,54 @@
+//
+// Created by cew05 on 19/10/2026.
+//
+
+#include "TestRunner.h"
+#include "../Gameplay/include/Position.h"
+
+static const std::string START_FEN = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+/*
+ * FEN
+ */
+
+TEST(FENRoundTrip) {
+    const char* fens[] = {
+            "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+            "rnbqkbnr/pppp1ppp/8/4p3/4P3/8/PPPP1PPP/RNBQKBNR w KQkq e6 0 2",
+            "r3k2r/8/8/8/8/8/8/R3K2R b Kq - 5 40",
+            "8/8/8/3k4/8/8/8/4K3 w - - 0 1",
+    };
+
+    for (const char* fen : fens) {
+        Position position;
+        CHECK(position.FromFEN(fen));
+        CHECK_EQ(position.ToFEN(), std::string(fen));
+    }
+}
+
+TEST(FENStateEnPassant) {
+    // an en passant target is always written, never followed by a second "-"
+    CHECK_EQ(Position::FENState('b', 0xF, Position::Square('e', 3), 0, 1), std::string(" b KQkq e3 0 1"));
+    CHECK_EQ(Position::FENState('w', 0, Position::Square('d', 6), 0, 3), std::string(" w - d6 0 3"));
+    CHECK_EQ(Position::FENState('w', 0, Position::NO_SQUARE, 0, 1), std::string(" w - - 0 1"));
+}
+
+TEST(FENStateCastlingOrder) {
+    // KQkq order whichever side's rights were added first
+    uint8_t castling = Position::BLACK_QUEENSIDE | Position::BLACK_KINGSIDE | Position::WHITE_KINGSIDE;
+    CHECK_EQ(Position::FENState('w', castling, Position::NO_SQUARE, 0, 1), std::string(" w Kkq - 0 1"));
+}
+
+TEST(FENAfterDoublePush) {
+    Position position;
+    CHECK(position.FromFEN(START_FEN));
+    position.Apply(position.ParseUCI("e2e4"));
+    CHECK_EQ(position.ToFEN(), std::string("rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1"));
+}
+
+TEST(FENRejectsMalformed) {
+    Position position;
+    CHECK(!position.FromFEN(""));
+    CHECK(!position.FromFEN("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP w KQkq - 0 1"));
+    CHECK(!position.FromFEN("rnbqkbnr/pppppppp/9/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"));
+}
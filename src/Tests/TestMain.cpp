@@ -0,0 +1,25 @@
+//
+// Created by cew05 on 19/10/2026.
+//
+
+#include "TestRunner.h"
+
+int main(int argc, char** argv) {
+    // optional filter, only runs tests whose name contains it
+    std::string filter = (argc > 1) ? argv[1] : "";
+
+    int nRun = 0, nFailed = 0;
+    for (const TestCase& test : TestCases()) {
+        if (!filter.empty() && std::string(test.name).find(filter) == std::string::npos) continue;
+
+        bool failed = false;
+        test.body(failed);
+        printf("%s %s\n", failed ? "FAIL" : "ok  ", test.name);
+
+        nRun++;
+        if (failed) nFailed++;
+    }
+
+    printf("%d tests, %d failed\n", nRun, nFailed);
+    return nFailed == 0 ? 0 : 1;
+}
@@ -0,0 +1,50 @@
+//
+// Created by cew05 on 19/10/2026.
+//
+
+#ifndef CHESS_WITH_SDL_TESTRUNNER_H
+#define CHESS_WITH_SDL_TESTRUNNER_H
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <functional>
+
+/*
+ * Minimal test registry, TEST bodies register themselves before main and CHECK marks the running test failed
+ */
+
+struct TestCase {
+    const char* name;
+    std::function<void(bool&)> body;
+};
+
+inline std::vector<TestCase>& TestCases() {
+    static std::vector<TestCase> cases;
+    return cases;
+}
+
+struct TestRegistrar {
+    TestRegistrar(const char* _name, std::function<void(bool&)> _body) {
+        TestCases().push_back({_name, std::move(_body)});
+    }
+};
+
+#define TEST(name) \
+    static void name(bool& _failed); \
+    static TestRegistrar name##Registrar(#name, name); \
+    static void name(bool& _failed)
+
+#define CHECK(condition) \
+    do { if (!(condition)) { printf("  %s:%d CHECK(%s) failed\n", __FILE__, __LINE__, #condition); _failed = true; } } while (0)
+
+#define CHECK_EQ(actual, expected) \
+    do { \
+        auto _actual = (actual); auto _expected = (expected); \
+        if (!(_actual == _expected)) { \
+            printf("  %s:%d CHECK_EQ(%s, %s) failed\n", __FILE__, __LINE__, #actual, #expected); \
+            _failed = true; \
+        } \
+    } while (0)
+
+#endif //CHESS_WITH_SDL_TESTRUNNER_H
@@ -0,0 +1,122 @@
+//
+// Created by cew05 on 19/10/2026.
+//
+
+#include "src_headers/TextureLoader.h"
+#include "src_headers/GlobalSource.h"
+
+#include <SDL_image.h>
+#include <cstdint>
+
+TextureLoader::TextureLoader(int _workers) {
+    // default to one worker per core, leaving one for the main thread
+    if (_workers <= 0) _workers = std::max((int)std::thread::hardware_concurrency() - 1, 1);
+
+    for (int w = 0; w < _workers; w++) {
+        workers.emplace_back([this]() { WorkerLoop(); });
+    }
+}
+
+TextureLoader::~TextureLoader() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    queueCondition.notify_all();
+
+    for (auto& worker : workers) {
+        if (worker.joinable()) worker.join();
+    }
+
+    // discard anything never uploaded
+    for (auto& request : decoded) {
+        if (request.surface != nullptr) SDL_FreeSurface(request.surface);
+    }
+}
+
+void TextureLoader::WorkerLoop() {
+    while (true) {
+        Request request;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueCondition.wait(lock, [this]() { return stopping || !requests.empty(); });
+            if (stopping) return;
+
+            request = std::move(requests.front());
+            requests.pop_front();
+        }
+
+        // decode outside the lock
+        request.surface = IMG_Load(request.path.c_str());
+        if (request.surface == nullptr) {
+            printf("Failed to decode %s: %s\n", request.path.c_str(), SDL_GetError());
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            decoded.push_back(std::move(request));
+        }
+        doneCondition.notify_all();
+    }
+}
+
+void TextureLoader::Queue(const std::string& _path, int _textureID) {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        requests.push_back({_path, _textureID, nullptr});
+        inFlight++;
+    }
+    queueCondition.notify_one();
+}
+
+int TextureLoader::Upload(TextureManager* _tm, int _maxUploads) {
+    // a negative limit uploads everything decoded
+    size_t maxUploads = (_maxUploads < 0) ? SIZE_MAX : size_t(_maxUploads);
+
+    // take the finished decodes, then upload without holding the lock
+    std::deque<Request> ready;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        while (!decoded.empty() && ready.size() < maxUploads) {
+            ready.push_back(std::move(decoded.front()));
+            decoded.pop_front();
+        }
+    }
+
+    int uploaded = 0;
+    for (auto& request : ready) {
+        if (request.surface != nullptr) {
+            SDL_Texture* texture = SDL_CreateTextureFromSurface(window.renderer, request.surface);
+            SDL_FreeSurface(request.surface);
+
+            if (texture == nullptr) LogError("Failed to upload texture", SDL_GetError(), false);
+            else if (_tm->UpdateTexture(texture, request.textureID)) uploaded++;
+        }
+
+        std::lock_guard<std::mutex> lock(queueMutex);
+        inFlight--;
+    }
+
+    return uploaded;
+}
+
+void TextureLoader::Finish(TextureManager* _tm) {
+    /*
+     * Blocks until every queued texture is decoded and uploaded. Decodes keep running in parallel while uploading.
+     */
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            if (inFlight == 0) return;
+            doneCondition.wait(lock, [this]() { return !decoded.empty(); });
+        }
+
+        Upload(_tm);
+    }
+}
+
+bool TextureLoader::IsIdle() {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    return inFlight == 0;
+}
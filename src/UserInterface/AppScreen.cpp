@@ -88,6 +88,22 @@ void AppScreen::ResizeScreen() {
     // ...
 }
 
+void AppScreen::QueueTextureJobs(TextureRebuildQueue& _queue) {
+    /*
+     * Same work as CreateTextures, split so that each menu and button is rebuilt as its own job
+     */
+
+    for (auto &menu : *menuManager->AccessMap()) {
+        Menu* menuPtr = menu.second;
+        _queue.Push([menuPtr]() { return menuPtr->CreateTextures(); });
+    }
+
+    for (auto &button : *buttonManager->AccessMap()) {
+        Button* buttonPtr = button.second;
+        _queue.Push([buttonPtr]() { return buttonPtr->CreateTextures(); });
+    }
+}
+
 
 void AppScreen::UpdateButtonStates() {
     // If ignoreInput, return
@@ -110,6 +126,9 @@ void AppScreen::HandleEvents() {
     SDL_Event event;
 
     while (SDL_PollEvent(&event) != 0) {
+        // Input may change what is drawn, render at least the next frame before idling again
+        framePacer.KeepAwake();
+
         // Check for window close
         if (event.type == SDL_QUIT) {
             stateManager->ChangeResource(true, WINDOW_CLOSED);
@@ -118,12 +137,23 @@ void AppScreen::HandleEvents() {
 
         // Check other events
         switch (event.type) {
+            case SDL_MOUSEMOTION:
+                mouse.MoveTo(event.motion.x, event.motion.y);
+                break;
             case SDL_MOUSEBUTTONDOWN:
+                mouse.MoveTo(event.button.x, event.button.y);
                 mouse.MouseDown(true);
                 break;
             case SDL_MOUSEBUTTONUP:
+                mouse.MoveTo(event.button.x, event.button.y);
                 mouse.MouseDown(false);
                 break;
+            case SDL_KEYDOWN:
+                // Frame profiler overlay / CSV export
+                if (event.key.keysym.sym == SDLK_F3) frameProfiler.ToggleOverlay();
+                if (event.key.keysym.sym == SDLK_F4) frameProfiler.ExportCSV();
+                HandleKey(event.key.keysym.sym);
+                break;
             default:
                 break;
         }
@@ -133,6 +163,10 @@ void AppScreen::HandleEvents() {
 }
 
 
+void AppScreen::HandleKey(SDL_Keycode _key) {
+    // Child classes will overwrite this function to respond to key presses
+}
+
 void AppScreen::CheckButtons() {
     // Child classes will overwrite this function to check button states and execute functions
 }
@@ -141,7 +175,7 @@ bool AppScreen::FetchScreenState(int _stateID) {
     bool result;
     if (!stateManager->FetchResource(result, _stateID)) {
         result = false;
-        printf("FAILED TO FETCH ID %d CAUSE : %s\n", _stateID, GenericManager<bool>::GetIssueString(stateManager->GetIssue()).c_str());
+        printf("FAILED TO FETCH ID %d CAUSE : NOT REGISTERED\n", _stateID);
     }
     return result;
 }
@@ -9,11 +9,6 @@ Button::Button(std::pair<int, int> _position, std::pair<int, int> _size, const s
     label = _label;
     iconID = ButtonTexture::ICON_NONE;
     buttonRect = {_position.first, _position.second, _size.first, _size.second};
-
-    // Create texture resources
-    buttonTextures->NewTexture(nullptr, ButtonTexture::NORMAL);
-    buttonTextures->NewTexture(nullptr, ButtonTexture::HOVER);
-    buttonTextures->NewTexture(nullptr, ButtonTexture::CLICKED);
 }
 
 Button::Button(std::pair<int, int> _position, std::pair<int, int> _size, int _iconID) :
@@ -28,17 +23,43 @@ Button::Button(std::pair<int, int> _position, std::pair<int, int> _size, int _ic
     iconID = _iconID;
 }
 
+ButtonTextureKey Button::FetchTextureKey() const {
+    return {buttonRect.w, buttonRect.h, label, iconID, usingButtonIcon, int(textBorder * 1000)};
+}
+
 bool Button::CreateTextures() {
+    // Reuse the textures of an identical button if one has already drawn them
+    ButtonTextureKey key = FetchTextureKey();
+    std::shared_ptr<ButtonTextureSet> shared = buttonTextureCache.Fetch(key);
+
+    if (shared == nullptr) {
+        ButtonTextureSet set;
+        if (!DrawTextures(set)) {
+            for (SDL_Texture* texture : set.textures) {
+                if (texture != nullptr) SDL_DestroyTexture(texture);
+            }
+            return false;
+        }
+        shared = buttonTextureCache.Store(key, set);
+    }
+
+    // Releases the previous set, destroying it if no other button uses it
+    buttonTextures = shared;
+    edgeRadius = buttonTextures->edgeRadius;
+    hoverSample = UINT64_MAX;
+
+    return true;
+}
+
+bool Button::DrawTextures(ButtonTextureSet& _set) {
     // temp vars
     tm->OpenTexture(BUTTON_SHEET);
     SDL_Texture* buttonSheet = tm->AccessTexture(BUTTON_SHEET);
-    TTF_Font* font = TTF_OpenFont("../Resources/Fonts/CF/TCFR.ttf", 100);
 
     std::pair<int, int> textureGrid = tm->AccessInfo(BUTTON_SHEET)->grid;
     std::pair<int, int> tgSize;
     SDL_Rect srcRect, destRect;
 
-    ButtonTexture ids[] = {ButtonTexture::NORMAL, ButtonTexture::HOVER, ButtonTexture::CLICKED};
     for (int t = 0; t < 3; t++) {
         // Create texture to draw to
         SDL_Texture* buttonTexture = SDL_CreateTexture(window.renderer,
@@ -47,12 +68,17 @@ bool Button::CreateTextures() {
                                                        buttonRect.w, buttonRect.h);
         if (buttonTexture == nullptr) {
             LogError("Failed to create button texture", SDL_GetError());
+            SDL_SetRenderTarget(window.renderer, nullptr);
+            tm->CloseTexture(BUTTON_SHEET);
             return false;
         }
+        _set.textures[t] = buttonTexture;
 
         // Set renderTarget
         if (SDL_SetRenderTarget(window.renderer, buttonTexture) != 0) {
             LogError("Failed to set render target", SDL_GetError());
+            SDL_SetRenderTarget(window.renderer, nullptr);
+            tm->CloseTexture(BUTTON_SHEET);
             return false;
         }
 
@@ -96,19 +122,12 @@ bool Button::CreateTextures() {
 
         // If the label is not empty, draw the label
         if (!label.empty()) {
-            SDL_Surface *textSurface = TTF_RenderText_Blended(font, label.c_str(), {255, 255, 255, 255});
-            SDL_Texture *textTexture = SDL_CreateTextureFromSurface(window.renderer, textSurface);
-
-            // Resize texture
-            int labelW, labelH;
-            SDL_QueryTexture(textTexture, nullptr, nullptr, &labelW, &labelH);
-            sf = (double) labelH / ((double)buttonRect.h * (1 - 2 * textBorder));
-            labelH = int((double)buttonRect.h * (1 - 2 * textBorder));
-            labelW = int((double) labelW / sf);
+            // Size label to the button height
+            int labelH = int((double)buttonRect.h * (1 - 2 * textBorder));
+            int labelW = fontCache->GetTextWidth(label, labelH);
 
             // Centralise label in button
-            destRect = {buttonRect.w / 2 - labelW / 2, int(textBorder * (double)buttonRect.h), labelW, labelH};
-            SDL_RenderCopy(window.renderer, textTexture, nullptr, &destRect);
+            fontCache->RenderText(label, buttonRect.w / 2 - labelW / 2, int(textBorder * (double)buttonRect.h), labelH);
         }
 
         // Check for drawing an icon, and if the icon is part of the global texture manager
@@ -136,10 +155,8 @@ bool Button::CreateTextures() {
             }
         }
 
-        buttonTextures->UpdateTexture(buttonTexture, ids[t]);
-
         // store edgeRadius
-        edgeRadius = drWidth / 2;
+        _set.edgeRadius = drWidth / 2;
     }
 
 //    SDL_Surface* surface = SDL_CreateRGBSurface(0, buttonRect.w, buttonRect.h, 32, 0, 0, 0, 0);
@@ -152,7 +169,6 @@ bool Button::CreateTextures() {
 
     // Close textures
     tm->CloseTexture(BUTTON_SHEET);
-    TTF_CloseFont(font);
 
     return true;
 }
@@ -176,11 +192,11 @@ bool Button::Display() {
     ButtonTexture id = (MouseOverButton()) ? ButtonTexture::HOVER : ButtonTexture::NORMAL;
     if (clickStarted) id = ButtonTexture::CLICKED;
 
-    SDL_Texture* buttonTexture = buttonTextures->AccessTexture(id);
-    if (buttonTexture == nullptr) {
-        LogError(TextureManager::GetIssueString(buttonTextures->GetIssue()), "");
+    if (buttonTextures == nullptr) {
+        LogError("Button textures have not been created", "");
         return false;
     }
+    SDL_Texture* buttonTexture = buttonTextures->textures[id];
     if (SDL_RenderCopy(window.renderer, buttonTexture, nullptr, &buttonRect) != 0) {
         LogError("Failed to display Button", SDL_GetError(), false);
         return false;
@@ -199,39 +215,42 @@ void Button::UpdateSize(std::pair<int, int> _size) {
     double sf = (double)_size.first / buttonRect.w ;
     buttonRect.w = _size.first;
     buttonRect.h = (lockRatio ? int(buttonRect.h * sf) : _size.second);
+    hoverSample = UINT64_MAX;
 }
 
 void Button::UpdatePosition(std::pair<int, int> _position) {
     buttonRect.x = _position.first;
     buttonRect.y = _position.second;
+    hoverSample = UINT64_MAX;
 }
 
 
 bool Button::MouseOverButton() {
-    bool hover = false;
-
-    // Is the mouse hovering over the left edge of the button
-    if (mouse.InRadius({buttonRect.x + edgeRadius, buttonRect.y + edgeRadius}, edgeRadius))
-        hover = true;
-
-    // If the width is greater than height, is the mouse hovering over the middle rect
-    if (buttonRect.w > buttonRect.h) {
-        if (mouse.InRect({buttonRect.x+edgeRadius, buttonRect.y, buttonRect.w - 2*edgeRadius, buttonRect.h}))
-            hover = true;
+    // Only hit test once per mouse sample
+    if (hoverSample != mouse.GetSample()) {
+        hover = TestHover();
+        hoverSample = mouse.GetSample();
     }
 
-    // Is the mouse hovering over the right edge of the button
-    if (mouse.InRadius({buttonRect.x + buttonRect.w - edgeRadius, buttonRect.y + edgeRadius}, edgeRadius))
-        hover = true;
+    return hover;
+}
+
+bool Button::TestHover() {
+    // Bounding rect first, most buttons are not under the mouse
+    if (!mouse.InRect(buttonRect)) return false;
 
     // if width and height are the same, circular button
-    if (buttonRect.w == buttonRect.h) {
-        if (mouse.InRadius({buttonRect.x + buttonRect.w / 2, buttonRect.y + buttonRect.h/2}, buttonRect.w/2)) {
-            hover = true;
-        }
+    if (buttonRect.w <= buttonRect.h) {
+        return mouse.InRadius({buttonRect.x + buttonRect.w / 2, buttonRect.y + buttonRect.h / 2}, buttonRect.w / 2);
     }
 
-    return hover;
+    // If the width is greater than height, is the mouse hovering over the middle rect
+    if (mouse.InRect({buttonRect.x + edgeRadius, buttonRect.y, buttonRect.w - 2 * edgeRadius, buttonRect.h}))
+        return true;
+
+    // Is the mouse hovering over the left or right edge of the button
+    return mouse.InRadius({buttonRect.x + edgeRadius, buttonRect.y + edgeRadius}, edgeRadius) ||
+           mouse.InRadius({buttonRect.x + buttonRect.w - edgeRadius, buttonRect.y + edgeRadius}, edgeRadius);
 }
 
 void Button::UpdateClickedStatus() {
@@ -0,0 +1,29 @@
+//
+// Created by cew05 on 19/10/2026.
+//
+
+#include "include/ButtonTextureCache.h"
+
+std::shared_ptr<ButtonTextureSet> ButtonTextureCache::Fetch(const ButtonTextureKey& _key) {
+    auto it = sets.find(_key);
+    if (it == sets.end()) return nullptr;
+
+    // expired sets are removed by their deleter, lock can still fail while one is being destroyed
+    return it->second.lock();
+}
+
+std::shared_ptr<ButtonTextureSet> ButtonTextureCache::Store(const ButtonTextureKey& _key, const ButtonTextureSet& _set) {
+    // the last owner destroys the textures and removes the entry, unless it has since been replaced
+    std::shared_ptr<ButtonTextureSet> shared(new ButtonTextureSet(_set), [this, _key](ButtonTextureSet* _expired) {
+        for (SDL_Texture* texture : _expired->textures) {
+            if (texture != nullptr) SDL_DestroyTexture(texture);
+        }
+
+        auto it = sets.find(_key);
+        if (it != sets.end() && it->second.expired()) sets.erase(it);
+        delete _expired;
+    });
+
+    sets[_key] = shared;
+    return shared;
+}
@@ -3,6 +3,7 @@
 //
 
 #include <memory>
+#include <cctype>
 
 #include "include/GameScreen.h"
 
@@ -10,7 +11,7 @@ GameScreen::GameScreen(char _teamID) : AppScreen() {
     // Temp vars
     Menu* menu;
     Button* button;
-    GenericManager<Button*>* menuButtonManager;
+    ButtonManager* menuButtonManager;
 
     // Setup for pieces and board
     teamPieces = std::make_unique<std::vector<std::unique_ptr<Piece>>>();  // set team as white goes first (hence is current team)
@@ -19,11 +20,24 @@ GameScreen::GameScreen(char _teamID) : AppScreen() {
     SetUpBoard();
     SetUpPieces();
 
-    board->WriteStartPositionsToFile(*teamPieces, *oppPieces); // whitePieces , blackPieces
-
     // Set users turn
+    userTeamID = _teamID;
     usersTurn = (_teamID == 'W');
 
+    // Set time control and engine search limits from config
+    SetTimeControl(FetchConfigValue("ClockBaseSeconds", 600) * 1000,
+                   FetchConfigValue("ClockIncrementSeconds", 5) * 1000);
+
+    std::string mode = FetchConfigValue("EngineSearchMode", "clock");
+    SetEngineSearchLimits((mode == "depth") ? SearchMode::DEPTH : (mode == "movetime") ? SearchMode::MOVETIME : SearchMode::CLOCK,
+                          FetchConfigValue("EngineDepth", 10),
+                          FetchConfigValue("EngineMoveTime", 1000));
+    engineWatchdog = FetchConfigValue("EngineWatchdogMs", 30000);
+
+    // Open the opening book, the engine is used alone if this fails
+    book->Open(FetchConfigValue("OpeningBook", "../RequiredFiles/Book/book.bin"),
+               FetchConfigValue("OpeningBookRandom", "../RequiredFiles/Book/Random64.bin"));
+
     /*
      * Construct OPTIONS menu (back to menu, resign, offer draw)
      */
@@ -60,27 +74,54 @@ GameScreen::GameScreen(char _teamID) : AppScreen() {
     stateManager->NewResource(true, ALL_TASKS_COMPLETE);
     stateManager->NewResource(false, CHECKMATE);
     stateManager->NewResource(false, STALEMATE);
+    stateManager->NewResource(false, TIME_OUT);
+    stateManager->NewResource(false, BOARD_FLIPPED);
+    stateManager->NewResource(false, DRAW_OFFER);
+    stateManager->NewResource(false, RESIGN);
 }
 
 void GameScreen::SetUpBoard() {
     // Setup Board
     board->SetBoardPos(100, 0);
+}
+
+bool GameScreen::OpenGameFiles() {
+    /*
+     * Creates the GameData files of the game about to be played and opens the analysis cache. Run on the first tick
+     * of each game rather than on construction, so a GameScreen that is never played (e.g. in the render bench)
+     * writes nothing to disk.
+     */
+
+    gameFilesOpen = true;
+
+    // Open analysis cache once, results are not cached if this fails
+    if (!analysisCache->IsOpen()) {
+        analysisCache->Open(FetchConfigValue("AnalysisCache", "../RequiredFiles/AnalysisCache.bin"),
+                            FetchConfigValue("AnalysisCacheSlots", 1 << 16));
+    }
 
-    // Ensure GameData directory exists else end program
+    // Ensure GameData directory exists, the game is still played without files if not
     if (!board->GameDataDirectoryExists()) {
         printf("Failed to ensure game directory exists");
-        return;
+        return false;
     }
     board->ClearExcessGameFiles();
+
     // Create game data files in dir
     if (!board->CreateGameFiles()) {
         printf("Error creating game files.\n");
-        return;
+        return false;
     }
+
+    // whitePieces, blackPieces
+    if (GetSideToMove() == 'W') board->WriteStartPositionsToFile(*teamPieces, *oppPieces);
+    else board->WriteStartPositionsToFile(*oppPieces, *teamPieces);
+    return true;
 }
 
 void GameScreen::SetUpPieces() {
-    // Clear old pieces
+    // Clear old pieces, and the selection which points into them
+    selectedPiece->ChangeSelectedPiece(nullptr);
     teamPieces->clear();
     oppPieces->clear();
 
@@ -134,10 +175,113 @@ void GameScreen::SetUpPieces() {
     }
     boardStandardFile.close();
 
+    // White always starts the standard setup
+    board->SetTurn('w', 1);
+    usersTurn = (userTeamID == 'W');
+
+    // Record start of game for the engine and the game record
+    gameStartFEN = board->CreateFEN(*teamPieces, *oppPieces);
+    uciMoveList.clear();
+    board->RecordStart(gameStartFEN);
+    PublishSnapshot();
+
     printf("CONSTRUCTED %zu WHITE PIECES, %zu BLACK PIECES, %zu TOTAL PIECES\n",
            teamPieces->size(), oppPieces->size(), teamPieces->size() + oppPieces->size());
 }
 
+bool GameScreen::SetUpPiecesFromFEN(const std::string& _fen) {
+    /*
+     * Places pieces from a FEN string, used to drive the board from scripted positions. The FEN is validated first
+     * and the board left as it was if it is malformed. The side to move becomes the team pieces, and castling rights
+     * and the en passant target are carried over to the kings, rooks and pawns.
+     */
+
+    Position position;
+    if (!position.FromFEN(_fen)) {
+        printf("Invalid FEN %s\n", _fen.c_str());
+        return false;
+    }
+
+    int nKings[2] = {0, 0};
+    for (int square = 0; square < 64; square++) {
+        char c = position.PieceOn(square);
+        if (c == 'K' || c == 'k') nKings[c == 'k']++;
+        if ((c == 'P' || c == 'p') && (square < 8 || square >= 56)) {
+            printf("Pawn on a back rank in FEN %s\n", _fen.c_str());
+            return false;
+        }
+    }
+    if (nKings[0] != 1 || nKings[1] != 1) {
+        printf("FEN %s must have one king per side\n", _fen.c_str());
+        return false;
+    }
+
+    selectedPiece->ChangeSelectedPiece(nullptr);
+    teamPieces->clear();
+    oppPieces->clear();
+
+    uint8_t castling = position.Castling();
+    char sideToMove = (position.SideToMove() == 'b') ? 'B' : 'W';
+
+    for (int square = 0; square < 64; square++) {
+        char c = position.PieceOn(square);
+        if (c == 0) continue;
+
+        char colID = std::isupper(c) ? 'W' : 'B';
+        std::pair<char, int> gamepos = {char('a' + square % 8), square / 8 + 1};
+        int backRank = (colID == 'W') ? 1 : 8;
+        bool kingside = castling & ((colID == 'W') ? Position::WHITE_KINGSIDE : Position::BLACK_KINGSIDE);
+        bool queenside = castling & ((colID == 'W') ? Position::WHITE_QUEENSIDE : Position::BLACK_QUEENSIDE);
+
+        std::unique_ptr<Piece> newPiecePtr = nullptr;
+        switch (std::tolower(c)) {
+            case 'p':
+                newPiecePtr = std::make_unique<Piece>(colID);
+                newPiecePtr->SetMoved(gamepos.second != ((colID == 'W') ? 2 : 7));
+                break;
+            case 'n': newPiecePtr = std::make_unique<Knight>(colID); break;
+            case 'b': newPiecePtr = std::make_unique<Bishop>(colID); break;
+            case 'q': newPiecePtr = std::make_unique<Queen>(colID); break;
+            case 'r':
+                // only a rook in its corner with the matching right may castle
+                newPiecePtr = std::make_unique<Rook>(colID);
+                newPiecePtr->SetMoved(!(gamepos.second == backRank &&
+                                        ((gamepos.first == 'h' && kingside) || (gamepos.first == 'a' && queenside))));
+                break;
+            case 'k':
+                newPiecePtr = std::make_unique<King>(colID);
+                if (gamepos != std::pair<char, int>{'e', backRank}) kingside = queenside = false;
+                newPiecePtr->SetCastlingRights(queenside, kingside);
+                newPiecePtr->SetMoved(!kingside && !queenside);
+                break;
+            default:
+                break;
+        }
+
+        // the pawn that just moved two squares, one square past the target
+        if (position.EpSquare() != Position::NO_SQUARE && std::tolower(c) == 'p' && colID != sideToMove &&
+            square == position.EpSquare() + ((colID == 'W') ? 8 : -8)) {
+            newPiecePtr->SetPassant();
+        }
+
+        newPiecePtr->CreateTextures();
+        newPiecePtr->SetPos(gamepos);
+        newPiecePtr->SetRects(board);
+
+        if (colID == sideToMove) teamPieces->push_back(std::move(newPiecePtr));
+        else oppPieces->push_back(std::move(newPiecePtr));
+    }
+
+    board->SetTurn(position.SideToMove(), position.FullMove());
+    usersTurn = (sideToMove == userTeamID);
+
+    gameStartFEN = _fen;
+    uciMoveList.clear();
+    board->RecordStart(gameStartFEN);
+    PublishSnapshot();
+    return true;
+}
+
 void GameScreen::SetupEngine(bool _limitStrength, int _elo, int _level) {
     std::string funcStr;
 
@@ -145,10 +289,13 @@ void GameScreen::SetupEngine(bool _limitStrength, int _elo, int _level) {
     if (sfm == nullptr) {
         printf("WARNING SUBPROCESS STOCKFISH OPENED, CHECK FOR CLOSURE ON PROGRAM END\n");
         sfm = std::make_unique<StockfishManager>();
+        sfm->SetMetricsFile(FetchConfigValue("EngineMetricsFile", "../RequiredFiles/EngineMetrics.txt"));
+        sfm->SetQuitWait(FetchConfigValue("EngineQuitWaitMs", 600));
+        sfm->StartAsync();
     }
     else {
         // SF already opened, indicate a new game by setting the start position
-        funcStr = "position startpos\n";
+        funcStr = "ucinewgame\nposition startpos\n";
         sfm->DoFunction(funcStr);
     }
 
@@ -161,12 +308,14 @@ void GameScreen::SetupEngine(bool _limitStrength, int _elo, int _level) {
         // ensure min/max elo bounds not exceeded
         _elo = std::min(_elo, 3190);
         _elo = std::max(_elo, 1320);
+        engineElo = _elo;
         funcStr = "setoption name UCI_Elo value " + std::to_string(_elo) + "\n";
         sfm->DoFunction(funcStr);
 
         // ensure min/max skill level bounds not exceeded
         _level = std::min(_level, 20);
         _level = std::max(_level, 0);
+        engineSkill = _level;
         funcStr = "setoption name Skill Level value " + std::to_string(_level) + "\n";
         sfm->DoFunction(funcStr);
     }
@@ -174,6 +323,20 @@ void GameScreen::SetupEngine(bool _limitStrength, int _elo, int _level) {
     funcStr = "setoption name UCI_LimitStrength value ";
     funcStr += ((_limitStrength) ? "true\n" : "false\n");
     sfm->DoFunction(funcStr);
+
+    // limited strength is part of the analysis cache key, results at one strength are not reused at another
+    engineLimitStrength = _limitStrength;
+}
+
+void GameScreen::SetTimeControl(int _baseMs, int _incMs) {
+    // a base time of 0 disables the clock, in which case the engine falls back to movetime searches
+    clock = std::make_unique<GameClock>(std::max(_baseMs, 0), std::max(_incMs, 0));
+}
+
+void GameScreen::SetEngineSearchLimits(SearchMode _mode, int _depth, int _moveTime) {
+    searchMode = _mode;
+    searchDepth = std::max(_depth, 1);
+    searchMoveTime = std::max(_moveTime, 10);
 }
 
 std::string GameScreen::FetchOpponentMove() {
@@ -184,40 +347,145 @@ std::string GameScreen::FetchOpponentMove() {
     return FENstr;
 }
 
+bool GameScreen::IsGameOver() const {
+    bool cm = false, sm = false, to = false, resigned = false;
+    stateManager->FetchResource(cm, CHECKMATE);
+    stateManager->FetchResource(sm, STALEMATE);
+    stateManager->FetchResource(to, TIME_OUT);
+    stateManager->FetchResource(resigned, RESIGN);
+    return cm || sm || to || resigned;
+}
+
+char GameScreen::GetSideToMove() const {
+    return (board->GetHalfTurn() % 2 == 0) ? 'W' : 'B';
+}
+
+std::string GameScreen::CreateGoCommand() const {
+    /*
+     * Creates the go command for the engine. Clock searches pass the remaining time of both sides so that the engines
+     * own TimeManagement decides how long to think; depth searches are kept for analysis only as their wall time is
+     * unbounded.
+     */
+
+    switch (searchMode) {
+        case SearchMode::DEPTH:
+            return "go depth " + std::to_string(searchDepth) + "\n";
+
+        case SearchMode::CLOCK:
+            if (clock->GetRemaining('W') > 0 && clock->GetRemaining('B') > 0) {
+                return "go wtime " + std::to_string(clock->GetRemaining('W')) +
+                       " btime " + std::to_string(clock->GetRemaining('B')) +
+                       " winc " + std::to_string(clock->GetIncrement('W')) +
+                       " binc " + std::to_string(clock->GetIncrement('B')) + "\n";
+            }
+            // no clock set, use movetime
+            [[fallthrough]];
+
+        case SearchMode::MOVETIME:
+        default:
+            return "go movetime " + std::to_string(searchMoveTime) + "\n";
+    }
+}
+
+Uint64 GameScreen::GetEngineLatencyBudget() const {
+    /*
+     * Rough upper bound on how long the engine may take to reply to CreateGoCommand. For clock searches this is a flat
+     * 84% of the remaining time of the side to move, a conservative estimate rather than Stockfish's own time
+     * management. Returns 0 for depth searches as there is no bound.
+     */
+
+    // allowance for pipe io and engine move overhead
+    const Uint64 overhead = 50;
+
+    switch (searchMode) {
+        case SearchMode::DEPTH:
+            return 0;
+
+        case SearchMode::CLOCK:
+            if (clock->GetRemaining('W') > 0 && clock->GetRemaining('B') > 0) {
+                return Uint64((double)clock->GetRemaining(GetSideToMove()) * 0.84) + overhead;
+            }
+            [[fallthrough]];
+
+        case SearchMode::MOVETIME:
+        default:
+            return searchMoveTime + overhead;
+    }
+}
+
 std::string GameScreen::FetchOpponentMoveEngine(const std::vector<std::unique_ptr<Piece>>& _teamPieces,
                                                 const std::vector<std::unique_ptr<Piece>>& _oppPieces) {
     // Get FEN of current position
     std::string FENstr = board->CreateFEN(_teamPieces, _oppPieces);
     //printf("GET MOVE FROM FEN %s\n", FENstr.c_str());
 
+    // Use a book move when one exists for the position
+    std::string bookMove = book->FetchMove(FENstr);
+    if (!bookMove.empty()) {
+        printf("BOOK MOVE %s\n", bookMove.c_str());
+        return bookMove;
+    }
+
+    // Use a previous engine result for the position and search limits if one has been cached
+    uint64_t cacheKey = AnalysisCache::CreateKey(FENstr, CreateSearchParams());
+    AnalysisResult result;
+    if (analysisCache->Probe(cacheKey, result)) {
+        printf("CACHED MOVE %s (depth %d)\n", result.bestMove.c_str(), result.depth);
+        return result.bestMove;
+    }
+
+    // Engine could not be started earlier in this game, do not try again every turn
+    if (engineUnavailable) return FetchFallbackMove(_teamPieces);
+
     if (sfm == nullptr) {
         SetupEngine(true, 1500, 10);
     }
 
-    std::string cmd;
+    // Engine is starting or restarting in the background, ask again next tick rather than blocking on it
+    if (sfm->IsStarting()) {
+        if (!waitingForEngine) printf("WAITING FOR ENGINE\n");
+        waitingForEngine = true;
+        return {};
+    }
+    waitingForEngine = false;
 
-    // Get response to request to find bestmove
-    cmd = "position fen " + FENstr + "\n";
-    sfm->DoFunction(cmd);
+    if (!sfm->IsReady()) {
+        printf("ENGINE FAILED TO START, OPPONENT PLAYS RANDOM MOVES\n");
+        engineUnavailable = true;
+        return FetchFallbackMove(_teamPieces);
+    }
 
-    sfm->DoFunction("go depth 10\n");
+    // Send the game from its start position so the engine knows the move history (repetitions), and so the watchdog
+    // can replay it to a restarted engine
+    std::string cmd = "position fen " + gameStartFEN;
+    if (!uciMoveList.empty()) {
+        cmd += " moves";
+        for (const auto& move : uciMoveList) cmd += " " + move;
+    }
+    cmd += "\n";
 
-    // read lines of response untill finding "bestmove ..." line
-    std::string response = sfm->FetchResult(), line;
-    char delim = '\n';
-    size_t pos = response.find(delim);
+    // Allow twice the latency budget before the watchdog intervenes
+    Uint64 budget = GetEngineLatencyBudget();
+    auto timeout = (unsigned long)((budget == 0) ? engineWatchdog : budget * 2 + 1000);
+
+    std::vector<std::string> lines;
+    if (!sfm->SearchBestMove(cmd, CreateGoCommand(), timeout, lines)) {
+        // the watchdog restarts a stuck engine in the background, the move is asked for again once it is ready
+        if (sfm->IsStarting()) return {};
+
+        printf("ENGINE FAILED TO RETURN A MOVE, OPPONENT PLAYS RANDOM MOVES\n");
+        engineUnavailable = true;
+        return FetchFallbackMove(_teamPieces);
+    }
 
-    while ((line = response.substr(0, pos+1)).find("bestmove") == std::string::npos) {
-        //printf("Line %s\n", line.c_str());
-        response.erase(0, pos+1);
-        if (response.empty()) response = sfm->FetchResult();
-        pos = response.find(delim);
+    for (const auto& infoLine : lines) {
+        ParseInfoLine(infoLine, result);
     }
-    //printf("Success Line %s\n", line.c_str());
+    std::string line = lines.back();
 
     // convert response string into only movestring [targetpos][destpos][promoteTo]
-    delim = ' ';
-    pos = line.find(delim);
+    char delim = ' ';
+    size_t pos = line.find(delim);
     line.erase(0, pos+1);
 
     // remove trailing text after space
@@ -230,11 +498,90 @@ std::string GameScreen::FetchOpponentMoveEngine(const std::vector<std::unique_pt
         if (!isalpha(line[4])) line.erase(4, std::string::npos);
     }
 
+    // cache the result for later games / sessions
+    result.bestMove = line;
+    analysisCache->Store(cacheKey, result);
+
     return line;
 }
 
+std::string GameScreen::FetchFallbackMove(const std::vector<std::unique_ptr<Piece>>& _teamPieces) {
+    /*
+     * Random legal move in the engine's [position][destination][promotion] format, used when the engine cannot reply
+     * so the game carries on instead of waiting for a move that never comes. Promotions are always to a queen
+     */
+
+    std::vector<std::string> moves;
+    for (const auto& piece : _teamPieces) {
+        auto pieceInfo = piece->GetPieceInfoPtr();
+        for (const auto& move : *piece->GetAvailableMovesPtr()) {
+            auto target = move.GetPosition();
+
+            std::string moveStr;
+            moveStr += pieceInfo->gamepos.first;
+            moveStr += std::to_string(pieceInfo->gamepos.second);
+            moveStr += target.first;
+            moveStr += std::to_string(target.second);
+            if (pieceInfo->name == "Pawn" && (target.second == 1 || target.second == 8)) moveStr += 'q';
+
+            moves.push_back(moveStr);
+        }
+    }
+
+    if (moves.empty()) return {};
+    return moves[std::uniform_int_distribution<size_t>(0, moves.size() - 1)(fallbackRng)];
+}
+
+void GameScreen::ParseInfoLine(const std::string& _line, AnalysisResult& _result) {
+    /*
+     * Reads the depth and score from an engine "info" line into _result. Lines without a score (currmove etc.) are
+     * ignored.
+     */
+
+    if (_line.compare(0, 5, "info ") != 0 || _line.find(" score ") == std::string::npos) return;
+
+    std::istringstream ss(_line);
+    std::string token;
+    while (ss >> token) {
+        if (token == "depth") ss >> _result.depth;
+        else if (token == "score") {
+            ss >> token;
+            _result.mateScore = (token == "mate");
+            ss >> _result.score;
+        }
+    }
+}
+
+std::string GameScreen::CreateSearchParams() const {
+    /*
+     * Describes the engine strength and search limits for the analysis cache key. Limited strength engines are keyed
+     * on their Elo and skill level. Depth and movetime searches are keyed on their exact limit. Clock searches are
+     * bucketed by the power of two of their latency budget as the exact clock values are rarely repeated.
+     */
+
+    std::string params;
+    if (engineLimitStrength) params = "elo " + std::to_string(engineElo) + " skill " + std::to_string(engineSkill) + " ";
+
+    switch (searchMode) {
+        case SearchMode::DEPTH:
+            return params + "depth " + std::to_string(searchDepth);
+
+        case SearchMode::CLOCK:
+            if (clock->GetRemaining('W') > 0 && clock->GetRemaining('B') > 0) {
+                return params + "clock " + std::to_string((int)std::log2(std::max(GetEngineLatencyBudget(), (Uint64)1)));
+            }
+            // no clock set, CreateGoCommand uses movetime
+            [[fallthrough]];
+
+        case SearchMode::MOVETIME:
+        default:
+            return params + "movetime " + std::to_string(searchMoveTime);
+    }
+}
+
 bool GameScreen::CreateTextures() {
     if (!AppScreen::CreateTextures()) return false;
+    std::lock_guard<std::mutex> layoutLock(layoutMutex);
 
     // Create board textures
     board->CreateBoardTexture();
@@ -268,28 +615,62 @@ bool GameScreen::Display() {
     // Display board
     board->DisplayGameBoard();
 
-    // Display team Pieces
-    for (const auto& piece : *teamPieces) {
-        piece->DisplayPiece(board);
-        piece->DisplayMoves(board);
+    // Take the latest state published by the simulation, otherwise keep drawing the last one
+    snapshots.Consume();
+    const RenderSnapshot& snapshot = snapshots.ReadBuffer();
+
+    // Pieces, highlights and move markers all come from the atlas and are drawn in a single call
+    pieceBatch.Begin(tm->AccessTexture(PIECE_ATLAS));
+    for (const auto& piece : snapshot.pieces) {
+        Piece::DisplaySnapshot(piece, board, pieceBatch);
     }
+    pieceBatch.Flush();
+
+    // Display move hints of the selected piece. a1's rect changes with any resize, move or flip of the board, and the
+    // batch holds the atlas texture so it is also recomposed when the atlas is recreated
+    SDL_Rect tileRect;
+    board->GetTileRectFromPosition(tileRect, {'a', 1});
+
+    if (snapshot.moveHints != hintMoves || hintAtlasVersion != PIECE_ATLAS_VERSION ||
+        tileRect.x != hintTileRect.x || tileRect.y != hintTileRect.y ||
+        tileRect.w != hintTileRect.w || tileRect.h != hintTileRect.h) {
+        moveHintBatch.Begin(tm->AccessTexture(PIECE_ATLAS));
+        for (const MoveHint& hint : snapshot.moveHints) {
+            SDL_Rect moveRect;
+            board->GetBorderedRectFromPosition(moveRect, hint.square);
+            moveHintBatch.Add(GetAtlasRect(hint.atlasCell), moveRect);
+        }
 
-    // Display opp Pieces
-    for (const auto& piece : *oppPieces) {
-        piece->DisplayPiece(board);
-        piece->DisplayMoves(board);
+        hintMoves = snapshot.moveHints;
+        hintTileRect = tileRect;
+        hintAtlasVersion = PIECE_ATLAS_VERSION;
+    }
+    if (!moveHintBatch.Draw()) {
+        // recompose from scratch next frame
+        printf("Failed to draw move hints\n");
+        hintAtlasVersion = -1;
     }
 
     // Display the promotion menu if required
-    stateManager->FetchResource(state, SHOW_PROMO_MENU);
-    if (state) {
-        board->DisplayPromoMenu(teamPieces->back());
+    if (snapshot.promoColID != 0) {
+        board->DisplayPromoMenu(snapshot.promoColID);
     }
 
     // Display options menu
     menuManager->FetchResource(menu, OPTIONS_MENU);
     menu->Display();
 
+    // Display both clocks at the bottom of the options menu, the side to move is drawn brighter
+    if (!snapshot.clocks[0].empty()) {
+        const int lineH = 24;
+        int y = window.currentRect.h - 2 * lineH - 10;
+        for (char colID : {'B', 'W'}) {
+            SDL_Color colour = (colID == snapshot.sideToMove) ? SDL_Color {255, 255, 255, 255} : SDL_Color {150, 150, 150, 255};
+            fontCache->RenderText(std::string(1, colID) + " " + snapshot.clocks[colID == 'B'], 10, y, lineH, colour);
+            y += lineH;
+        }
+    }
+
     // If end of game, display the endgame menu
     // ...
 
@@ -310,23 +691,67 @@ void GameScreen::ResizeScreen() {
     menuManager->ChangeResource(menu, OPTIONS_MENU);
 
     // Resize board
+    std::lock_guard<std::mutex> layoutLock(layoutMutex);
     board->FillToBounds(window.currentRect.w, window.currentRect.h);
     menuManager->FetchResource(menu, OPTIONS_MENU);
     objRect = menu->FetchMenuRect();
     board->SetBoardPos(objRect.w, 0);
 
     // Resize pieces
-    // ...
+    for (const auto& piece : *teamPieces) piece->SetRects(board);
+    for (const auto& piece : *oppPieces) piece->SetRects(board);
+}
+
+void GameScreen::QueueTextureJobs(TextureRebuildQueue& _queue) {
+    AppScreen::QueueTextureJobs(_queue);
+
+    // Board textures
+    _queue.Push([this]() {
+        std::lock_guard<std::mutex> layoutLock(layoutMutex);
+        return board->CreateBoardTexture() == 0;
+    });
+    _queue.Push([this]() {
+        std::lock_guard<std::mutex> layoutLock(layoutMutex);
+        return board->CreatePromoMenuTexture();
+    });
 }
 
 void GameScreen::HandleEvents() {
     AppScreen::HandleEvents();
 
+    // Game logic runs on the simulation thread with this frame's mouse
+    PostCommand({SimCommand::Type::TICK, mouse});
+}
+
+void GameScreen::Simulate(std::unique_lock<std::mutex>& _layoutLock) {
+    /*
+     * One tick of game logic, run with the board layout locked. The lock is only released while waiting on the engine
+     * so that the main thread can resize the board meanwhile
+     */
+
+    // Game files are created when the game is first played
+    if (!gameFilesOpen) OpenGameFiles();
+
+    // Buffered journal moves are written out once the flush interval passes, even while nobody moves
+    board->TickGameFiles();
+
     // If end of game has been reached, do not proceed with event loop
-    bool cm = false, sm = false;
-    stateManager->FetchResource(cm, CHECKMATE);
-    stateManager->FetchResource(sm, STALEMATE);
-    if (cm || sm) return;
+    if (IsGameOver()) return;
+
+    /*
+     * UPDATE CLOCK
+     */
+
+    if (!clock->IsRunning()) clock->Start(GetSideToMove());
+
+    if (clock->HasFlagged(GetSideToMove())) {
+        printf("TIME OUT! %s\n", (GetSideToMove() == 'W') ? "0:1" : "1:0");
+        clock->Stop();
+        stateManager->ChangeResource(true, TIME_OUT);
+        board->RecordResult((GetSideToMove() == 'W') ? GameResult::BLACK_WIN : GameResult::WHITE_WIN);
+        board->FlushGameFiles();
+        return;
+    }
 
     // game states
     bool eot;
@@ -339,11 +764,14 @@ void GameScreen::HandleEvents() {
      * FETCH PIECE MOVES
      */
 
-    for (const auto& piece : *teamPieces) {
-        piece->ClearMoves();
-        piece->ClearNextMoves();
-        piece->FetchMoves(*teamPieces, *oppPieces, board);
-        piece->PreventMoveIntoCheck(*teamPieces, *oppPieces, board);
+    {
+        ProfileScope scope(ProfilePhase::MOVE_GENERATION);
+        for (const auto& piece : *teamPieces) {
+            piece->ClearMoves();
+            piece->ClearNextMoves();
+            piece->FetchMoves(*teamPieces, *oppPieces, board);
+            piece->PreventMoveIntoCheck(*teamPieces, *oppPieces, board);
+        }
     }
 
     /*
@@ -365,12 +793,17 @@ void GameScreen::HandleEvents() {
             // conditions met: checkmate
             printf("CHECKMATE! 1:0");
             stateManager->ChangeResource(true, CHECKMATE);
+            board->RecordResult((GetSideToMove() == 'W') ? GameResult::BLACK_WIN : GameResult::WHITE_WIN);
         } else {
             // conditions met: stalemate
             printf("STALEMATE! 0.5:0.5");
             stateManager->ChangeResource(true, STALEMATE);
+            board->RecordResult(GameResult::DRAW);
         }
 
+        // End of game, write out the rest of the journal
+        board->FlushGameFiles();
+
         // Show results, store final game results, wait for input to return to menu
     }
 
@@ -379,8 +812,25 @@ void GameScreen::HandleEvents() {
      */
 
     if (usersTurn) {
+        // square under the mouse is resolved once, pieces only compare their position with it
+        std::pair<char, int> mouseSquare;
+        bool mouseOnBoard = board->GetSquareFromPixel(mouse.GetMousePosition(), mouseSquare);
+
+        // a piece still held from last frame blocks clicks on the others
+        Piece* clickedPiece = nullptr;
         for (const auto& piece : *teamPieces) {
-            piece->UpdateClickedStatus(*teamPieces);
+            if (piece->IsClicked()) {
+                clickedPiece = piece.get();
+                break;
+            }
+        }
+
+        for (const auto& piece : *teamPieces) {
+            bool onSquare = mouseOnBoard && piece->GetPieceInfoPtr()->gamepos == mouseSquare;
+            piece->UpdateClickedStatus(clickedPiece != nullptr && clickedPiece != piece.get(), onSquare);
+
+            if (piece.get() == clickedPiece && !piece->IsClicked()) clickedPiece = nullptr;
+            else if (clickedPiece == nullptr && piece->IsClicked()) clickedPiece = piece.get();
         }
 
         // check if user has clicked on a move
@@ -405,9 +855,16 @@ void GameScreen::HandleEvents() {
     std::string basicMoveStr;
 
     if (!usersTurn) {
+        // keep drawing while the engine replies
+        framePacer.KeepAwake();
+        ProfileScope scope(ProfilePhase::ENGINE_WAIT);
+        _layoutLock.unlock();
         basicMoveStr = FetchOpponentMoveEngine(*teamPieces, *oppPieces);
+        _layoutLock.lock();
         //printf("movegiven : %s, L:%zu\n", basicMoveStr.c_str(), basicMoveStr.length());
+    }
 
+    if (!usersTurn && basicMoveStr.length() >= 4) {
         std::pair<char, int> pos = {basicMoveStr[0], basicMoveStr[1] - '0'};
         std::pair<char, int> target = {basicMoveStr[2], basicMoveStr[3] - '0'};
         Piece* movPiece = Piece::GetTeamPieceOnPosition(*teamPieces, pos);
@@ -518,12 +975,16 @@ void GameScreen::HandleEvents() {
         // Create and get the lastMove string
         selectedPiece->CreateACNstring(*teamPieces);
         board->WriteMoveToFile(selectedPiece->GetACNMoveString());
+        uciMoveList.push_back(selectedPiece->GetUCIMoveString());
+        board->RecordMove(uciMoveList.back());
 
         // change turn
+        clock->Press();
         std::swap(teamPieces, oppPieces);
         board->IncrementTurn();
         usersTurn = !usersTurn;
         eot = false;
+        framePacer.KeepAwake();
         printf("ENDTURN\n");
 
     }
@@ -539,7 +1000,7 @@ void GameScreen::CheckButtons() {
     // temp vars
     Menu* menu;
     Button* button;
-    GenericManager<Button*>* buttonManager;
+    ButtonManager* buttonManager;
 
     /*
      * OPTIONSMENU
@@ -551,6 +1012,7 @@ void GameScreen::CheckButtons() {
     // Return to homescreen
     buttonManager->FetchResource(button, OM_HOME_SCREEN);
     if (button->IsClicked()) {
+        PostCommand({SimCommand::Type::STOP_CLOCK});
         screenManager->FetchResource(currentScreen, HOMESCREEN);
         currentScreen->ResizeScreen();
         currentScreen->CreateTextures();
@@ -559,7 +1021,7 @@ void GameScreen::CheckButtons() {
     // Resign current game
     buttonManager->FetchResource(button, OM_RESIGN);
     if (button->IsClicked()) {
-        stateManager->ChangeResource(true, RESIGN);
+        PostCommand({SimCommand::Type::RESIGN});
     }
 
 
@@ -573,18 +1035,172 @@ void GameScreen::CheckButtons() {
     // New Game
     buttonManager->FetchResource(button, OM_NEWGAME);
     if (button->IsClicked()) {
-        SetUpPieces();
-
-        // Reset CM/SM
-        stateManager->ChangeResource(false, CHECKMATE);
-        stateManager->ChangeResource(false, STALEMATE);
+        PostCommand({SimCommand::Type::NEW_GAME});
     }
 
 
     // Flip board
     buttonManager->FetchResource(button, OM_FLIP_BOARD);
     if (button->IsClicked()) {
-        stateManager->ChangeResource(true, BOARD_FLIPPED);
+        bool flipped;
+        stateManager->FetchResource(flipped, BOARD_FLIPPED);
+        stateManager->ChangeResource(!flipped, BOARD_FLIPPED);
+
+        // Compiled board for the other orientation is usually cached, pieces follow their tiles
+        std::lock_guard<std::mutex> layoutLock(layoutMutex);
+        board->SetFlipped(!flipped);
+        board->CreateBoardTexture();
+        for (const auto& piece : *teamPieces) piece->SetRects(board);
+        for (const auto& piece : *oppPieces) piece->SetRects(board);
     }
 
-}
\ No newline at end of file
+}
+
+/*
+ * SIMULATION THREAD
+ */
+
+GameScreen::~GameScreen() {
+    StopSimulation();
+}
+
+void GameScreen::StartSimulation() {
+    if (simRunning) return;
+
+    simRunning = true;
+    simThread = std::thread(&GameScreen::SimulationLoop, this);
+}
+
+void GameScreen::StopSimulation() {
+    if (!simRunning) return;
+
+    // Queued ticks are dropped, an engine search in progress is waited for
+    {
+        std::lock_guard<std::mutex> lock(simMutex);
+        simRunning = false;
+        simCommands.clear();
+    }
+    simWake.notify_one();
+    simThread.join();
+}
+
+void GameScreen::PostCommand(const SimCommand& _command) {
+    /*
+     * Queues the command for the simulation thread. Without a simulation thread (e.g. the render bench) the command is
+     * run immediately
+     */
+
+    std::unique_lock<std::mutex> lock(simMutex);
+    if (!simRunning) {
+        lock.unlock();
+        RunCommand(_command);
+        return;
+    }
+
+    // Ticks pile up while the engine is searching, drop the oldest rather than grow without bound
+    if (_command.type == SimCommand::Type::TICK && simCommands.size() >= maxQueuedTicks) {
+        auto oldest = std::find_if(simCommands.begin(), simCommands.end(), [](const SimCommand& _queued) {
+            return _queued.type == SimCommand::Type::TICK;
+        });
+        if (oldest != simCommands.end()) simCommands.erase(oldest);
+    }
+
+    simCommands.push_back(_command);
+    lock.unlock();
+    simWake.notify_one();
+}
+
+void GameScreen::RunCommand(const SimCommand& _command) {
+    std::unique_lock<std::mutex> layoutLock(layoutMutex);
+
+    switch (_command.type) {
+        case SimCommand::Type::TICK:
+            // Game logic reads this thread's mouse, which follows the main thread's a frame at a time
+            mouse = _command.mouse;
+            Simulate(layoutLock);
+            PublishSnapshot();
+            break;
+
+        case SimCommand::Type::NEW_GAME:
+            // Save the game being left before its record is restarted, the new game gets new files next tick
+            board->CloseGameFiles();
+            gameFilesOpen = false;
+            SetUpPieces();
+
+            // Reset CM/SM/clock
+            stateManager->ChangeResource(false, CHECKMATE);
+            stateManager->ChangeResource(false, STALEMATE);
+            stateManager->ChangeResource(false, TIME_OUT);
+            stateManager->ChangeResource(false, RESIGN);
+            stateManager->ChangeResource(false, DRAW_OFFER);
+            clock->Reset();
+            break;
+
+        case SimCommand::Type::STOP_CLOCK:
+            clock->Stop();
+            break;
+
+        case SimCommand::Type::RESIGN:
+            if (IsGameOver()) break;
+
+            printf("RESIGNED! %s\n", (userTeamID == 'W') ? "0:1" : "1:0");
+            clock->Stop();
+            stateManager->ChangeResource(true, RESIGN);
+            board->RecordResult((userTeamID == 'W') ? GameResult::BLACK_WIN : GameResult::WHITE_WIN);
+            board->FlushGameFiles();
+            break;
+    }
+}
+
+void GameScreen::SimulationLoop() {
+    while (true) {
+        SimCommand command;
+        {
+            std::unique_lock<std::mutex> lock(simMutex);
+            simWake.wait(lock, [this]() { return !simRunning || !simCommands.empty(); });
+            if (!simRunning) return;
+
+            command = simCommands.front();
+            simCommands.pop_front();
+        }
+
+        RunCommand(command);
+    }
+}
+
+void GameScreen::PublishSnapshot() {
+    /*
+     * Copies the display state of the game into the write buffer and hands it to Display. Called from the simulation
+     * only, or from the main thread before the simulation has started
+     */
+
+    RenderSnapshot& snapshot = snapshots.WriteBuffer();
+    snapshot.pieces.clear();
+    snapshot.moveHints.clear();
+    snapshot.promoColID = 0;
+
+    for (const auto& pieces : {teamPieces.get(), oppPieces.get()}) {
+        for (const auto& piece : *pieces) {
+            if (piece->IsCaptured()) continue;
+            snapshot.pieces.emplace_back();
+            piece->FillSnapshot(snapshot.pieces.back());
+        }
+    }
+
+    Piece* selected = selectedPiece->GetSelectedPiece();
+    if (selected != nullptr) selected->FetchMoveHints(snapshot.moveHints);
+
+    bool showPromo = false;
+    stateManager->FetchResource(showPromo, SHOW_PROMO_MENU);
+    if (showPromo && !teamPieces->empty()) snapshot.promoColID = teamPieces->back()->GetPieceInfoPtr()->colID;
+
+    snapshot.sideToMove = GetSideToMove();
+    for (char colID : {'W', 'B'}) {
+        snapshot.clocks[colID == 'B'] = clock->IsTimed() ? clock->GetClockString(colID) : "";
+    }
+
+    snapshots.Publish();
+
+    // Wake the main thread if it is idling so the new state is drawn
+    if (std::this_thread::get_id() == simThread.get_id()) FramePacer::Wake();
+}
@@ -56,7 +56,7 @@ void HomeScreen::CheckButtons() {
 
     Menu* menu;
     Button* button;
-    GenericManager<Button*>* menuButtonManager;
+    ButtonManager* menuButtonManager;
 
     // Fetch buttonManager from menu
     menuManager->FetchResource(menu, MAIN_MENU);
@@ -81,7 +81,10 @@ void HomeScreen::CheckButtons() {
     menuButtonManager->FetchResource(button, REVIEW_GAMES);
     if (button->IsClicked()) {
         printf("GAME REVIEW\n");
-
+        screenManager->FetchResource(currentScreen, REVIEWSCREEN);
+        currentScreen->LoadScreen();
+        currentScreen->ResizeScreen();
+        currentScreen->CreateTextures();
     }
 }
 
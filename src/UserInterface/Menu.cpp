@@ -21,7 +21,6 @@ Menu::Menu(std::pair<int, int> _position, std::pair<int, int> _size, const std::
 bool Menu::CreateTextures() {
     // Open textures
     tm->OpenTexture(MENU_SHEET);
-    TTF_Font* font = TTF_OpenFont("../Resources/Fonts/CF/TCFR.ttf", 100);
 
     // Open texture sheet
     SDL_Texture* menuSheet = tm->AccessTexture(MENU_SHEET);
@@ -83,19 +82,12 @@ bool Menu::CreateTextures() {
 
     // If the title is not empty, draw the title
     if (!menuTitle.empty()) {
-        SDL_Surface *textSurface = TTF_RenderText_Blended(font, menuTitle.c_str(), {255, 255, 255, 255});
-        SDL_Texture *textTexture = SDL_CreateTextureFromSurface(window.renderer, textSurface);
-
-        // Resize texture
-        int labelW, labelH;
-        SDL_QueryTexture(textTexture, nullptr, nullptr, &labelW, &labelH);
-        sf = (double) labelH / (menuRect.h / 14.0);
-        labelH = int(menuRect.h / 14.0);
-        labelW = int((double) labelW / sf);
+        // Size title to the menu height
+        int labelH = int(menuRect.h / 14.0);
+        int labelW = fontCache->GetTextWidth(menuTitle, labelH);
 
         // Centralise label in button
-        destRect = {menuRect.w / 2 - labelW / 2, int(labelH/10), labelW, labelH};
-        SDL_RenderCopy(window.renderer, textTexture, nullptr, &destRect);
+        fontCache->RenderText(menuTitle, menuRect.w / 2 - labelW / 2, int(labelH/10), labelH);
     }
 
     // reset renderTarget
@@ -114,7 +106,6 @@ bool Menu::CreateTextures() {
 
     // Close textures
     tm->CloseTexture(MENU_SHEET);
-    TTF_CloseFont(font);
 
     return true;
 }
@@ -201,7 +192,7 @@ void Menu::UpdateSize(std::pair<int, int> _size) {
 }
 
 
-GenericManager<Button*>* Menu::AccessButtonManager() {
+ButtonManager* Menu::AccessButtonManager() {
     return buttonManager;
 }
 
@@ -0,0 +1,294 @@
+//
+// Created by cew05 on 19/10/2026.
+//
+
+#include "include/ReviewScreen.h"
+
+ReviewScreen::ReviewScreen() : AppScreen() {
+    // Temp vars
+    Menu* menu;
+    Button* button;
+
+    board->SetBoardPos(100, 0);
+    keyframeInterval = std::max(FetchConfigValue("GameRecordKeyframeInterval", 16), 1);
+    review.SetKeyframeInterval(keyframeInterval);
+
+    /*
+     * Construct OPTIONS menu (back to menu, previous / next game, flip board)
+     */
+
+    menu = new Menu({0, 0}, {100, 500}, "");
+    menu->CanClose(false);
+
+    // Back to home screen
+    button = new Button({10, 10}, {80, 30}, "Home");
+    menu->AccessButtonManager()->NewResource(button, OM_HOME_SCREEN);
+
+    // Previous game
+    button = new Button({10, 110}, {80, 30}, "Prev Game");
+    menu->AccessButtonManager()->NewResource(button, OM_PREVIOUS_GAME);
+
+    // Next game
+    button = new Button({10, 210}, {80, 30}, "Next Game");
+    menu->AccessButtonManager()->NewResource(button, OM_NEXT_GAME);
+
+    // Flip Board
+    button = new Button({10, 310}, {80, 30}, "Flip Board");
+    menu->AccessButtonManager()->NewResource(button, OM_FLIP_BOARD);
+
+    menuManager->NewResource(menu, OPTIONS_MENU);
+
+    // Set states
+    stateManager->NewResource(false, BOARD_FLIPPED);
+    stateManager->NewResource(false, SCRUBBING);
+}
+
+/*
+ * GAMES
+ */
+
+bool ReviewScreen::LoadScreen() {
+    /*
+     * Reopens the database so games finished since the last visit are included, then shows the latest game. The
+     * board's database may be adding a game on the sim thread, so this one is only ever opened read only
+     */
+
+    if (!gameDatabase.Open(gameDatabaseDirPath, true)) {
+        printf("No game database found at %s\n", gameDatabaseDirPath.c_str());
+        review.Clear();
+        return false;
+    }
+
+    if (gameDatabase.GameCount() == 0) {
+        printf("No games to review\n");
+        review.Clear();
+        return true;
+    }
+
+    return LoadGame(gameDatabase.GameCount() - 1);
+}
+
+bool ReviewScreen::LoadGame(uint32_t _gameID) {
+    StoredGame game;
+    if (!gameDatabase.FetchGame(_gameID, game) || !review.Load(game)) {
+        printf("Failed to load game %u for review\n", _gameID);
+        return false;
+    }
+
+    gameID = _gameID;
+    batchPly = -1;
+    printf("Reviewing game %u of %u, %d plies\n", gameID + 1, gameDatabase.GameCount(), review.PlyCount());
+    return true;
+}
+
+/*
+ * DISPLAY
+ */
+
+bool ReviewScreen::CreateTextures() {
+    if (!AppScreen::CreateTextures()) return false;
+
+    board->CreateBoardTexture();
+    batchPly = -1;
+    return true;
+}
+
+void ReviewScreen::ComposePieces() {
+    /*
+     * Rebuilds the piece batch from the review's position. Only done when the ply changes, the board moves or the piece
+     * atlas is recreated, every other frame draws the batch as it is
+     */
+
+    SDL_Rect tileRect;
+    board->GetTileRectFromPosition(tileRect, {'a', 1});
+    if (batchPly == review.Ply() && batchAtlasVersion == PIECE_ATLAS_VERSION &&
+        tileRect.x == batchTileRect.x && tileRect.y == batchTileRect.y &&
+        tileRect.w == batchTileRect.w && tileRect.h == batchTileRect.h) return;
+
+    const Position& position = review.CurrentPosition();
+    Move16 lastMove = review.LastMove();
+
+    pieceBatch.Begin(tm->AccessTexture(PIECE_ATLAS));
+    for (int square = 0; square < 64; square++) {
+        char piece = position.PieceOn(square);
+        if (piece == 0) continue;
+
+        PieceSnapshot snapshot;
+        snapshot.textureID = Piece::TextureIDOf((char)std::toupper(piece), std::isupper(piece) ? 'W' : 'B');
+        snapshot.gamepos = {char('a' + square % 8), square / 8 + 1};
+        snapshot.lastpos = snapshot.gamepos;
+
+        // Show the last move made on the piece that made it
+        if (lastMove != Position::MOVE_NONE && square == Position::MoveTo(lastMove)) {
+            int from = Position::MoveFrom(lastMove);
+            snapshot.lastpos = {char('a' + from % 8), from / 8 + 1};
+            snapshot.showLastMove = true;
+        }
+
+        Piece::DisplaySnapshot(snapshot, board, pieceBatch);
+    }
+
+    batchPly = review.Ply();
+    batchTileRect = tileRect;
+    batchAtlasVersion = PIECE_ATLAS_VERSION;
+}
+
+bool ReviewScreen::Display() {
+    Menu* menu;
+
+    // Display screen background
+    SDL_SetRenderDrawColor(window.renderer, 102, 57, 49, 255);
+    SDL_RenderFillRect(window.renderer, &window.currentRect);
+
+    // Display board and pieces
+    board->DisplayGameBoard();
+    if (review.IsLoaded()) {
+        ComposePieces();
+        if (!pieceBatch.Draw()) {
+            printf("Failed to draw review pieces\n");
+            batchPly = -1;
+        }
+    }
+
+    // Display slider, filled up to the current ply
+    SDL_SetRenderDrawColor(window.renderer, 60, 33, 28, 255);
+    SDL_RenderFillRect(window.renderer, &sliderRect);
+    if (review.PlyCount() > 0) {
+        SDL_Rect filled = sliderRect;
+        filled.w = sliderRect.w * review.Ply() / review.PlyCount();
+        SDL_SetRenderDrawColor(window.renderer, 200, 170, 120, 255);
+        SDL_RenderFillRect(window.renderer, &filled);
+    }
+    SDL_SetRenderDrawColor(window.renderer, 0, 0, 0, 0);
+
+    // Display options menu
+    menuManager->FetchResource(menu, OPTIONS_MENU);
+    menu->Display();
+
+    return true;
+}
+
+void ReviewScreen::ResizeScreen() {
+    AppScreen::ResizeScreen();
+
+    // Temp vars
+    SDL_Rect objRect;
+    Menu* menu;
+
+    // Resize options menu to fit max dimensions
+    menuManager->FetchResource(menu, OPTIONS_MENU);
+    if (menu->FetchMenuRect().w > 100) menu->UpdateSize({150, menu->FetchMenuRect().h});
+    menuManager->ChangeResource(menu, OPTIONS_MENU);
+
+    // Resize board, leaving room for the slider below it
+    board->FillToBounds(window.currentRect.w, window.currentRect.h - sliderHeight);
+    menuManager->FetchResource(menu, OPTIONS_MENU);
+    objRect = menu->FetchMenuRect();
+    board->SetBoardPos(objRect.w, 0);
+
+    UpdateSliderRect();
+}
+
+void ReviewScreen::UpdateSliderRect() {
+    SDL_Rect menuRect;
+    Menu* menu;
+    int boardW, boardH;
+
+    menuManager->FetchResource(menu, OPTIONS_MENU);
+    menuRect = menu->FetchMenuRect();
+    board->GetBoardDimensions(boardW, boardH);
+
+    sliderRect = {menuRect.w + 10, boardH + 10, boardW - 20, sliderHeight - 20};
+}
+
+void ReviewScreen::QueueTextureJobs(TextureRebuildQueue& _queue) {
+    AppScreen::QueueTextureJobs(_queue);
+
+    // Board texture
+    _queue.Push([this]() {
+        return board->CreateBoardTexture() == 0;
+    });
+}
+
+/*
+ * EVENTS
+ */
+
+void ReviewScreen::HandleEvents() {
+    AppScreen::HandleEvents();
+
+    // Scrub while the mouse is held after pressing on the slider
+    bool scrubbing;
+    stateManager->FetchResource(scrubbing, SCRUBBING);
+    if (mouse.IsUnheldActive() && mouse.InRect(sliderRect)) scrubbing = true;
+    if (!mouse.IsHeldActive()) scrubbing = false;
+    stateManager->ChangeResource(scrubbing, SCRUBBING);
+
+    if (scrubbing) ScrubToMouse();
+}
+
+void ReviewScreen::ScrubToMouse() {
+    if (sliderRect.w <= 0) return;
+
+    int x = std::max(0, std::min(mouse.GetMousePosition().first - sliderRect.x, sliderRect.w));
+    review.SeekPly((x * review.PlyCount() + sliderRect.w / 2) / sliderRect.w);
+}
+
+void ReviewScreen::HandleKey(SDL_Keycode _key) {
+    switch (_key) {
+        case SDLK_RIGHT: review.StepForward(); break;
+        case SDLK_LEFT: review.StepBack(); break;
+        case SDLK_UP: review.SeekPly(review.Ply() + keyframeInterval); break;
+        case SDLK_DOWN: review.SeekPly(review.Ply() - keyframeInterval); break;
+        case SDLK_HOME: review.SeekPly(0); break;
+        case SDLK_END: review.SeekPly(review.PlyCount()); break;
+        default: break;
+    }
+}
+
+void ReviewScreen::CheckButtons() {
+    AppScreen::CheckButtons();
+
+    // temp vars
+    Menu* menu;
+    Button* button;
+    ButtonManager* buttonManager;
+
+    /*
+     * OPTIONSMENU
+     */
+
+    menuManager->FetchResource(menu, OPTIONS_MENU);
+    buttonManager = menu->AccessButtonManager();
+
+    // Return to homescreen
+    buttonManager->FetchResource(button, OM_HOME_SCREEN);
+    if (button->IsClicked()) {
+        screenManager->FetchResource(currentScreen, HOMESCREEN);
+        currentScreen->ResizeScreen();
+        currentScreen->CreateTextures();
+        return;
+    }
+
+    // Previous / next game
+    buttonManager->FetchResource(button, OM_PREVIOUS_GAME);
+    if (button->IsClicked() && gameID > 0) {
+        LoadGame(gameID - 1);
+    }
+
+    buttonManager->FetchResource(button, OM_NEXT_GAME);
+    if (button->IsClicked() && gameID + 1 < gameDatabase.GameCount()) {
+        LoadGame(gameID + 1);
+    }
+
+    // Flip board, pieces follow their tiles when the batch is recomposed
+    buttonManager->FetchResource(button, OM_FLIP_BOARD);
+    if (button->IsClicked()) {
+        bool flipped;
+        stateManager->FetchResource(flipped, BOARD_FLIPPED);
+        stateManager->ChangeResource(!flipped, BOARD_FLIPPED);
+
+        board->SetFlipped(!flipped);
+        board->CreateBoardTexture();
+    }
+}
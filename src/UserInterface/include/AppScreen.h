@@ -15,6 +15,9 @@
  * settings, selecting opponent ...).
  */
 
+// Sizes of the screen's enum ID spaces, ScreenState and each screen's GameState share the state IDs
+inline const int MAX_MENUS = 8, MAX_SCREEN_STATES = 32;
+
 class AppScreen {
     protected:
         // Display vars
@@ -26,12 +29,12 @@ class AppScreen {
         // Button Functionality enums
         enum buttonID : int;
 
-        // Local managers
-        GenericManager<Menu*>* menuManager = new GenericManager<Menu*>;
-        GenericManager<Button*>* buttonManager = new GenericManager<Button*>;
+        // Local managers, flat arrays indexed by the screen's enums
+        FlatManager<Menu*, MAX_MENUS>* menuManager = new FlatManager<Menu*, MAX_MENUS>;
+        ButtonManager* buttonManager = new ButtonManager;
         TextureManager* textureManager = new TextureManager(window.renderer);
 
-        GenericManager<bool>* stateManager = new GenericManager<bool>;
+        FlatManager<bool, MAX_SCREEN_STATES>* stateManager = new FlatManager<bool, MAX_SCREEN_STATES>;
 
     public:
         AppScreen();
@@ -43,10 +46,12 @@ class AppScreen {
 
         // respositioning
         virtual void ResizeScreen();
+        virtual void QueueTextureJobs(TextureRebuildQueue& _queue);
 
         // Event Handling
         void UpdateButtonStates();
         virtual void HandleEvents();
+        virtual void HandleKey(SDL_Keycode _key);
         virtual void CheckButtons();
 
         // Fetch states
@@ -62,10 +67,10 @@ class AppScreen {
 // Container for the Appscreen Children
 
 enum Screen : int {
-    HOMESCREEN, GAMESCREEN,
+    HOMESCREEN, GAMESCREEN, REVIEWSCREEN,
 };
 
-inline GenericManager<AppScreen*>* screenManager = new GenericManager<AppScreen*>;
+inline FlatManager<AppScreen*, 8>* screenManager = new FlatManager<AppScreen*, 8>;
 inline AppScreen* currentScreen = nullptr;
 
 #endif //CHESS_WITH_SDL_APPSCREEN_H
@@ -7,6 +7,7 @@
 
 #include "../../src_headers/GlobalResources.h"
 #include "SDL_ttf.h"
+#include "ButtonTextureCache.h"
 
 enum ButtonTexture : int {
     // enums to specify the base texture showing on user input
@@ -36,8 +37,16 @@ class Button {
         bool clickStarted = false;
         bool clicked = false;
 
-        // Local texture manager
-        TextureManager *buttonTextures = new TextureManager(window.renderer);
+        // Hover result for the current mouse sample, shared by Display and UpdateClickedStatus
+        bool hover = false;
+        Uint64 hoverSample = UINT64_MAX;
+        bool TestHover();
+
+        // State textures, shared with every button drawing the same content
+        std::shared_ptr<ButtonTextureSet> buttonTextures {};
+
+        [[nodiscard]] ButtonTextureKey FetchTextureKey() const;
+        bool DrawTextures(ButtonTextureSet& _set);
 
     public:
         Button(std::pair<int, int> _position, std::pair<int, int> _size, const std::string &_label);
@@ -62,5 +71,9 @@ class Button {
         [[nodiscard]] bool IsClicked() const;
 };
 
+// Button ids are small per screen / menu enums
+inline const int MAX_BUTTONS = 16;
+using ButtonManager = FlatManager<Button*, MAX_BUTTONS>;
+
 
 #endif //CHESS_WITH_SDL_BUTTON_H
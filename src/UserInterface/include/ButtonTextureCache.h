@@ -0,0 +1,51 @@
+//
+// Created by cew05 on 19/10/2026.
+//
+
+#ifndef CHESS_WITH_SDL_BUTTONTEXTURECACHE_H
+#define CHESS_WITH_SDL_BUTTONTEXTURECACHE_H
+
+#include <map>
+#include <memory>
+#include <string>
+#include <array>
+#include <tuple>
+#include <SDL.h>
+
+/*
+ * Content addressed cache of button state textures. Buttons that would draw identical textures (same size, label,
+ * icon and border) share one set of NORMAL / HOVER / CLICKED render targets. Sets are reference counted through
+ * shared_ptr, and destroyed when the last button using them is rebuilt or destroyed.
+ */
+
+struct ButtonTextureKey {
+    int w = 0, h = 0;
+    std::string label {};
+    int iconID = 0;
+    bool usingButtonIcon = true;
+    int textBorderPermille = 0;
+
+    bool operator<(const ButtonTextureKey& _other) const {
+        return std::tie(w, h, label, iconID, usingButtonIcon, textBorderPermille) <
+               std::tie(_other.w, _other.h, _other.label, _other.iconID, _other.usingButtonIcon, _other.textBorderPermille);
+    }
+};
+
+struct ButtonTextureSet {
+    std::array<SDL_Texture*, 3> textures {};
+    int edgeRadius = 0;
+};
+
+class ButtonTextureCache {
+    private:
+        std::map<ButtonTextureKey, std::weak_ptr<ButtonTextureSet>> sets {};
+
+    public:
+        std::shared_ptr<ButtonTextureSet> Fetch(const ButtonTextureKey& _key);
+        std::shared_ptr<ButtonTextureSet> Store(const ButtonTextureKey& _key, const ButtonTextureSet& _set);
+
+        [[nodiscard]] size_t Size() const { return sets.size(); };
+};
+inline ButtonTextureCache buttonTextureCache;
+
+#endif //CHESS_WITH_SDL_BUTTONTEXTURECACHE_H
@@ -6,16 +6,48 @@
 #define CHESS_WITH_SDL_GAMESCREEN_H
 
 #include <random>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
 #include "AppScreen.h"
+#include "../../src_headers/TripleBuffer.h"
 #include "../../Gameplay/include/Board.h"
 #include "../../Gameplay/include/IncludePieces.h"
+#include "../../Gameplay/include/GameClock.h"
 #include "../../StockfishUtil/StockfishManager.h"
+#include "../../StockfishUtil/PolyglotBook.h"
+#include "../../StockfishUtil/AnalysisCache.h"
 
 class GameScreen : public AppScreen {
     public:
         enum GameState : int {
             SHOW_PROMO_MENU = LAST_SCREEN_STATE, END_OF_TURN, ALL_TASKS_COMPLETE, CHECKMATE, STALEMATE,
-            DRAW_OFFER, RESIGN, BOARD_FLIPPED,
+            DRAW_OFFER, RESIGN, BOARD_FLIPPED, TIME_OUT,
+        };
+
+        enum class SearchMode : int {
+            DEPTH, MOVETIME, CLOCK,
+        };
+
+        // Everything Display needs from the game, published by the simulation after each tick
+        struct RenderSnapshot {
+            std::vector<PieceSnapshot> pieces {};
+            std::vector<MoveHint> moveHints {};
+            char promoColID = 0;
+
+            // white then black, empty when the game is untimed
+            std::string clocks[2] {};
+            char sideToMove = 'W';
+        };
+
+        // Work handed from the main thread to the simulation thread, run in order
+        struct SimCommand {
+            enum class Type : int {
+                TICK, NEW_GAME, STOP_CLOCK, RESIGN,
+            };
+            Type type = Type::TICK;
+            Mouse mouse {};
         };
 
     private:
@@ -32,32 +64,97 @@ class GameScreen : public AppScreen {
         std::unique_ptr<std::vector<std::unique_ptr<Piece>>> teamPieces;
         std::unique_ptr<std::vector<std::unique_ptr<Piece>>> oppPieces;
         //std::unique_ptr<std::vector<std::shared_ptr<Piece>>> allPieces;
+        SpriteBatch pieceBatch {};
+
+        // Move hints of the selected piece, recomposed only when the hints or board layout change
+        SpriteBatch moveHintBatch {};
+        std::vector<MoveHint> hintMoves {};
+        SDL_Rect hintTileRect {};
+        int hintAtlasVersion = -1;
+
+        // Simulation thread. Game state is only touched by the simulation, Display draws the latest snapshot. The
+        // board layout and piece rects are shared, so they are guarded by layoutMutex
+        TripleBuffer<RenderSnapshot> snapshots {};
+        std::thread simThread;
+        bool simRunning = false;
+        std::mutex simMutex;
+        std::condition_variable simWake;
+        std::deque<SimCommand> simCommands {};
+        std::mutex layoutMutex;
+        const size_t maxQueuedTicks = 256;
+
+        // Set once the current game's GameData files have been created
+        bool gameFilesOpen = false;
 
         // Stockfish
         std::unique_ptr<StockfishManager> sfm = nullptr;
+        std::unique_ptr<PolyglotBook> book = std::make_unique<PolyglotBook>();
+        std::unique_ptr<AnalysisCache> analysisCache = std::make_unique<AnalysisCache>();
+        bool engineLimitStrength = false;
+        int engineElo = 0;
+        int engineSkill = 20;
+        int engineWatchdog = 30000;
+
+        // Engine startup is polled each tick. Once the engine cannot be used the opponent plays random legal moves
+        bool waitingForEngine = false;
+        bool engineUnavailable = false;
+        std::mt19937 fallbackRng {std::random_device{}()};
+
+        // Game history sent to the engine
+        std::string gameStartFEN {};
+        std::vector<std::string> uciMoveList {};
+
+        // Engine search limits
+        SearchMode searchMode = SearchMode::CLOCK;
+        int searchDepth = 10;
+        int searchMoveTime = 1000;
 
         // Turn management
+        char userTeamID = 'W';
         bool usersTurn;
+        std::unique_ptr<GameClock> clock;
 
     public:
         explicit GameScreen(char _teamID);
+        ~GameScreen();
 
         // Game setup
         void SetUpBoard();
+        bool OpenGameFiles();
         void SetUpPieces();
+        bool SetUpPiecesFromFEN(const std::string& _fen);
         void SetupEngine(bool _limitStrength, int _elo, int _level);
+        void SetTimeControl(int _baseMs, int _incMs);
+        void SetEngineSearchLimits(SearchMode _mode, int _depth, int _moveTime);
 
         // Display
         bool CreateTextures() override;
         bool Display() override;
         void ResizeScreen() override;
+        void QueueTextureJobs(TextureRebuildQueue& _queue) override;
+
+        // Simulation
+        void StartSimulation();
+        void StopSimulation();
+        void PostCommand(const SimCommand& _command);
+        void RunCommand(const SimCommand& _command);
+        void SimulationLoop();
+        void Simulate(std::unique_lock<std::mutex>& _layoutLock);
+        void PublishSnapshot();
+        [[nodiscard]] bool IsGameOver() const;
 
         // Handle events
         void HandleEvents() override;
         void CheckButtons() override;
         std::string FetchOpponentMove();
+        [[nodiscard]] char GetSideToMove() const;
+        [[nodiscard]] std::string CreateGoCommand() const;
+        [[nodiscard]] Uint64 GetEngineLatencyBudget() const;
+        [[nodiscard]] std::string CreateSearchParams() const;
+        static void ParseInfoLine(const std::string& _line, AnalysisResult& _result);
         std::string FetchOpponentMoveEngine(const std::vector<std::unique_ptr<Piece>>& _teamPieces,
                                             const std::vector<std::unique_ptr<Piece>>& _oppPieces);
+        std::string FetchFallbackMove(const std::vector<std::unique_ptr<Piece>>& _teamPieces);
 };
 
 
@@ -19,7 +19,7 @@ class Menu {
         SDL_Rect menuRect {};
 
         // Local ResourceManagers
-        GenericManager<Button*>* buttonManager = new GenericManager<Button*>;
+        ButtonManager* buttonManager = new ButtonManager;
         TextureManager* textureManager = new TextureManager(window.renderer);
 
         // Functionality
@@ -50,7 +50,7 @@ class Menu {
         void UpdateSize(std::pair<int, int> _size);
 
         // Button functionality
-        GenericManager<Button*>* AccessButtonManager();
+        ButtonManager* AccessButtonManager();
         void UpdateButtonStates();
         virtual void CheckButtons();
 
@@ -0,0 +1,74 @@
+//
+// Created by cew05 on 19/10/2026.
+//
+
+#ifndef CHESS_WITH_SDL_REVIEWSCREEN_H
+#define CHESS_WITH_SDL_REVIEWSCREEN_H
+
+#include "AppScreen.h"
+#include "../../Gameplay/include/Board.h"
+#include "../../Gameplay/include/Piece.h"
+#include "../../Gameplay/include/GameDatabase.h"
+#include "../../Gameplay/include/GameReview.h"
+
+/*
+ * Replays games from the game database. The board is drawn from the review's position straight from the piece atlas, no
+ * Piece objects are built, and the batch is only recomposed when the ply or board layout changes. Left / right step a
+ * ply, up / down jump a keyframe interval, home / end go to the start / end, and the slider below the board scrubs.
+ */
+
+class ReviewScreen : public AppScreen {
+    public:
+        enum ReviewState : int {
+            BOARD_FLIPPED = LAST_SCREEN_STATE, SCRUBBING,
+        };
+
+    private:
+        enum MenuID : int {
+            OPTIONS_MENU,
+        };
+        enum buttonID : int {
+            OM_HOME_SCREEN, OM_PREVIOUS_GAME, OM_NEXT_GAME, OM_FLIP_BOARD,
+        };
+
+        std::unique_ptr<Board> board = std::make_unique<Board>();
+
+        // Pieces of the current ply, composed into the batch when the ply, a1's rect or the piece atlas changes
+        SpriteBatch pieceBatch {};
+        int batchPly = -1;
+        SDL_Rect batchTileRect {};
+        int batchAtlasVersion = -1;
+
+        // Games
+        std::string gameDatabaseDirPath = "../GameDatabase";
+        GameDatabase gameDatabase {};
+        GameReview review {};
+        int keyframeInterval = 16;
+        uint32_t gameID = 0;
+
+        // Slider below the board, one position per ply
+        SDL_Rect sliderRect {};
+        const int sliderHeight = 40;
+
+        bool LoadGame(uint32_t _gameID);
+        void ComposePieces();
+        void UpdateSliderRect();
+        void ScrubToMouse();
+
+    public:
+        ReviewScreen();
+
+        // Display
+        bool LoadScreen() override;
+        bool CreateTextures() override;
+        bool Display() override;
+        void ResizeScreen() override;
+        void QueueTextureJobs(TextureRebuildQueue& _queue) override;
+
+        // Handle events
+        void HandleEvents() override;
+        void HandleKey(SDL_Keycode _key) override;
+        void CheckButtons() override;
+};
+
+#endif //CHESS_WITH_SDL_REVIEWSCREEN_H
@@ -6,13 +6,16 @@
 #include <SDL.h>
 #include <SDL_ttf.h>
 
+#ifdef _WIN32
 #include <windows.h>
+#endif
 #include "StockfishUtil/StockfishManager.h"
 
 #include "src_headers/GlobalSource.h"
 #include "src_headers/GlobalResources.h"
 #include "UserInterface/include/HomeScreen.h"
 #include "UserInterface/include/GameScreen.h"
+#include "UserInterface/include/ReviewScreen.h"
 
 int EnsureWindowSize() {
     // Fetch rect of current window properties
@@ -64,8 +67,20 @@ int main(int argc, char** argv) {
         return 0;
     }
 
+    // Set frame pacing from config, vsync must be requested when creating the renderer
+    framePacer.SetMode(FetchConfigValue("FrameMode", "idle"));
+    framePacer.SetFrameCap(FetchConfigValue("FrameCap", 60));
+    framePacer.SetIdleTimeout(FetchConfigValue("IdleTimeoutMs", 250));
+
+    // Resize debounce and per frame texture rebuild budget
+    rebuildQueue.SetSettleTime(FetchConfigValue("ResizeSettleMs", 150));
+    rebuildQueue.SetBudget(FetchConfigValue("TextureRebuildBudgetMs", 4));
+    frameProfiler.SetCSVPath(FetchConfigValue("FrameProfileFile", "../RequiredFiles/FrameProfile.csv"));
+
     // Create renderer
-    window.renderer = SDL_CreateRenderer(window.window, 0, SDL_RENDERER_ACCELERATED);
+    Uint32 rendererFlags = SDL_RENDERER_ACCELERATED;
+    if (framePacer.GetMode() == FramePacer::Mode::VSYNC) rendererFlags |= SDL_RENDERER_PRESENTVSYNC;
+    window.renderer = SDL_CreateRenderer(window.window, 0, rendererFlags);
     if (!window.renderer) {
         LogError("Failed to create renderer", SDL_GetError(), true);
         return 0;
@@ -123,11 +138,20 @@ int main(int argc, char** argv) {
     GameScreen gs('W');
     gs.CreateTextures();
 
-    // Later should move this
+    // Engine is spawned and handshaken on a background thread, GameScreen only waits if it is needed before readyok
     gs.SetupEngine(true, 1320, 1);
 
     screenManager->NewResource(&gs, GAMESCREEN);
 
+    // Steps through recorded games from the game database
+    ReviewScreen rs;
+    rs.CreateTextures();
+
+    screenManager->NewResource(&rs, REVIEWSCREEN);
+
+    // Game logic and engine waits run off the render thread unless disabled
+    if (FetchConfigValue("SimulationThread", 1) != 0) gs.StartSimulation();
+
     // Loop utilises pointer to the current screen. Prevents multiple screens from attempting to manage events which
     // can lead to conflicts. Appscreen vector holds pointers to all current screens.
     screenManager->FetchResource(currentScreen, HOMESCREEN);
@@ -138,6 +162,7 @@ int main(int argc, char** argv) {
 
     // Set initial values of vars
     frameTick.currTick = SDL_GetTicks64();
+    mouse.UpdatePosition();
     bool running = true;
 
     // Loop
@@ -147,6 +172,9 @@ int main(int argc, char** argv) {
         frameTick.lastTick = frameTick.currTick;
         frameTick.currTick = SDL_GetTicks64();
         frameTick.tickChange = frameTick.currTick - frameTick.lastTick;
+        framePacer.StartFrame();
+        frameProfiler.NextFrame();
+        auto frameScope = std::make_unique<ProfileScope>(ProfilePhase::FRAME);
 
         // Clear screen
         SDL_RenderClear(window.renderer);
@@ -155,8 +183,14 @@ int main(int argc, char** argv) {
          *  DRAW TO SCREEN
          */
 
-        if (!currentScreen->Display())
-            running = false;
+        {
+            ProfileScope scope(ProfilePhase::DISPLAY);
+            if (!currentScreen->Display())
+                running = false;
+        }
+
+        // Phase timings, toggled with F3
+        frameProfiler.DisplayOverlay();
 
         /*
          *  USER INPUT AND HANDLE EVENTS
@@ -164,28 +198,50 @@ int main(int argc, char** argv) {
 
         // Handle events called first as this updates MouseInput vars (such as mouse down) required for updating button
         // states
-        currentScreen->HandleEvents();
-        currentScreen->UpdateButtonStates();
-        currentScreen->CheckButtons();
+        {
+            ProfileScope scope(ProfilePhase::HANDLE_EVENTS);
+            currentScreen->HandleEvents();
+        }
+        {
+            ProfileScope scope(ProfilePhase::UPDATE_BUTTONS);
+            currentScreen->UpdateButtonStates();
+        }
+        {
+            ProfileScope scope(ProfilePhase::CHECK_BUTTONS);
+            currentScreen->CheckButtons();
+        }
 
         /*
          *  RECREATE TEXTURES IF REQUIRED
          */
 
+        // Rects follow the window immediately and the old textures are drawn scaled. Textures are only rebuilt once
+        // the size has settled, a few jobs per frame
         int winSizeChanged = EnsureWindowSize();
         if (winSizeChanged == 1) {
             // ...
         }
         if (winSizeChanged != 0){
             currentScreen->ResizeScreen();
-            currentScreen->CreateTextures();
+            rebuildQueue.NotifyResize();
+        }
+
+        {
+            ProfileScope scope(ProfilePhase::TEXTURES);
+            if (rebuildQueue.Settled()) currentScreen->QueueTextureJobs(rebuildQueue);
+            rebuildQueue.Run();
         }
+        if (rebuildQueue.IsBusy()) framePacer.KeepAwake(rebuildQueue.GetSettleTime());
 
         /*
          *  UPDATE SCREEN
          */
 
         SDL_RenderPresent(window.renderer);
+        frameScope.reset();
+
+        // Sleep until the next frame is due, or until input arrives when idle
+        framePacer.EndFrame();
 
         /*
          * CHECK FOR EXIT CONDITION
@@ -194,6 +250,16 @@ int main(int argc, char** argv) {
         if (currentScreen->FetchScreenState(AppScreen::ScreenState::WINDOW_CLOSED)) running = false;
     }
 
+    // Export the frame profile of the session, F4 exports during play
+    if (FetchConfigValue("FrameProfileExportOnExit", 0) != 0) frameProfiler.ExportCSV();
+
+    // Simulation is joined before the resources it uses are released
+    gs.StopSimulation();
+
+    // Fonts must be closed before TTF is shut down, decode workers are joined
+    delete fontCache;
+    delete textureLoader;
+
     SDL_Quit();
     TTF_Quit();
 
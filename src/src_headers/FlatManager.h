@@ -0,0 +1,81 @@
+//
+// Created by cew05 on 19/10/2026.
+//
+
+#ifndef CHESS_WITH_SDL_FLATMANAGER_H
+#define CHESS_WITH_SDL_FLATMANAGER_H
+
+#include <array>
+#include <bitset>
+#include <utility>
+
+/*
+ * Drop in replacement for GenericManager<T> over a dense enum ID space [0, N). Resources live in a contiguous array with
+ * an occupancy bit per ID, so fetching or changing a resource is an array access. AccessMap returns the manager itself,
+ * iterating occupied {id, resource} pairs in ID order, so existing range-for loops over AccessMap() keep working.
+ */
+
+template<class T, int N>
+class FlatManager {
+    private:
+        std::array<std::pair<int, T>, N> slots {};
+        std::bitset<N> occupied {};
+
+    public:
+        class Iterator {
+            private:
+                FlatManager* manager;
+                int id;
+
+                void SkipEmpty() { while (id < N && !manager->occupied[id]) id++; };
+
+            public:
+                Iterator(FlatManager* _manager, int _id) : manager(_manager), id(_id) { SkipEmpty(); };
+
+                std::pair<int, T>& operator*() const { return manager->slots[id]; };
+                std::pair<int, T>* operator->() const { return &manager->slots[id]; };
+                Iterator& operator++() { id++; SkipEmpty(); return *this; };
+                bool operator!=(const Iterator& _other) const { return id != _other.id; };
+        };
+
+        FlatManager() {
+            for (int id = 0; id < N; id++) slots[id].first = id;
+        }
+
+        bool NewResource(T _resource, int _id) {
+            if (_id < 0 || _id >= N || occupied[_id]) return false;
+            slots[_id].second = std::move(_resource);
+            occupied[_id] = true;
+            return true;
+        }
+
+        bool FetchResource(T& _resource, int _id) const {
+            if (_id < 0 || _id >= N || !occupied[_id]) return false;
+            _resource = slots[_id].second;
+            return true;
+        }
+
+        bool ChangeResource(T _resource, int _id) {
+            if (_id < 0 || _id >= N || !occupied[_id]) return false;
+            slots[_id].second = std::move(_resource);
+            return true;
+        }
+
+        bool NewOrUpdateResource(T _resource, int _id) {
+            if (_id < 0 || _id >= N) return false;
+            slots[_id].second = std::move(_resource);
+            occupied[_id] = true;
+            return true;
+        }
+
+        [[nodiscard]] bool ResourceExists(int _id) const { return _id >= 0 && _id < N && occupied[_id]; };
+
+        // Unchecked access for hot paths where the ID is known to be registered
+        T& operator[](int _id) { return slots[_id].second; };
+
+        FlatManager* AccessMap() { return this; };
+        Iterator begin() { return {this, 0}; };
+        Iterator end() { return {this, N}; };
+};
+
+#endif //CHESS_WITH_SDL_FLATMANAGER_H
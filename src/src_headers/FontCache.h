@@ -0,0 +1,65 @@
+//
+// Created by cew05 on 19/10/2026.
+//
+
+#ifndef CHESS_WITH_SDL_FONTCACHE_H
+#define CHESS_WITH_SDL_FONTCACHE_H
+
+#include <map>
+#include <string>
+#include <array>
+#include <SDL.h>
+#include <SDL_ttf.h>
+
+#include "SpriteBatch.h"
+
+/*
+ * Process wide font cache. Each font is opened once, and the printable ASCII glyphs of the UI font are rasterised once
+ * into a single atlas texture. Text is then drawn as batched quads from the atlas, scaled to the requested height, so
+ * building labels never touches the filesystem or allocates surfaces.
+ */
+
+inline const char* UI_FONT_PATH = "../Resources/Fonts/CF/TCFR.ttf";
+inline const int UI_FONT_SIZE = 100;
+
+class FontCache {
+    private:
+        struct GlyphInfo {
+            SDL_Rect srcRect {};
+            int advance = 0;
+        };
+
+        static const char firstGlyph = ' ', lastGlyph = '~';
+
+        std::map<std::pair<std::string, int>, TTF_Font*> fonts {};
+
+        // Atlas of the UI font, glyphs are rendered in white and tinted by the vertex colour
+        TTF_Font* atlasFont = nullptr;
+        SDL_Texture* atlas = nullptr;
+        std::array<GlyphInfo, lastGlyph - firstGlyph + 1> glyphs {};
+        int fontHeight = 1;
+
+        SpriteBatch batch {};
+
+        [[nodiscard]] const GlyphInfo* FetchGlyph(char _c) const;
+
+    public:
+        ~FontCache();
+
+        // Fonts are opened on first request and kept until the cache is destroyed
+        TTF_Font* FetchFont(const std::string& _path, int _size);
+        bool CreateGlyphAtlas(const std::string& _path, int _size);
+
+        // Metrics of the atlas font, at the size it was rasterised
+        [[nodiscard]] TTF_Font* AccessAtlasFont() const { return atlasFont; };
+        [[nodiscard]] int GetFontHeight() const { return fontHeight; };
+        [[nodiscard]] int GetTextWidth(const std::string& _text, int _height) const;
+
+        // Add text to an atlas batch with its top left at (x, y), or draw it immediately
+        void AddText(SpriteBatch& _batch, const std::string& _text, int _x, int _y, int _height,
+                     SDL_Color _colour = {255, 255, 255, 255}) const;
+        bool RenderText(const std::string& _text, int _x, int _y, int _height, SDL_Color _colour = {255, 255, 255, 255});
+        [[nodiscard]] SDL_Texture* AccessAtlas() const { return atlas; };
+};
+
+#endif //CHESS_WITH_SDL_FONTCACHE_H
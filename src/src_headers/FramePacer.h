@@ -0,0 +1,76 @@
+//
+// Created by cew05 on 19/10/2026.
+//
+
+#ifndef CHESS_WITH_SDL_FRAMEPACER_H
+#define CHESS_WITH_SDL_FRAMEPACER_H
+
+#include <string>
+#include <algorithm>
+#include <atomic>
+#include <SDL.h>
+
+/*
+ * Paces the main loop. VSYNC leaves pacing to SDL_RenderPresent, CAPPED sleeps out the rest of each frame, and IDLE
+ * caps while something is animating but otherwise blocks in SDL_WaitEventTimeout until input arrives.
+ */
+
+class FramePacer {
+    public:
+        enum class Mode : int {
+            VSYNC, CAPPED, IDLE,
+        };
+
+    private:
+        Mode mode = Mode::IDLE;
+        Uint64 frameLength = 1000 / 60;
+        int idleTimeout = 250;
+
+        Uint64 frameStartTick = 0;
+        std::atomic<Uint64> awakeUntilTick {0};
+
+    public:
+        void SetMode(Mode _mode) { mode = _mode; };
+        void SetMode(const std::string& _mode) {
+            if (_mode == "vsync") mode = Mode::VSYNC;
+            else if (_mode == "capped") mode = Mode::CAPPED;
+            else mode = Mode::IDLE;
+        }
+        void SetFrameCap(int _fps) { frameLength = 1000 / std::max(_fps, 1); };
+        void SetIdleTimeout(int _ms) { idleTimeout = std::max(_ms, 1); };
+        [[nodiscard]] Mode GetMode() const { return mode; };
+
+        // Keep drawing frames, e.g. while a piece is animating or the engine is thinking. Safe from any thread
+        void KeepAwake(Uint64 _ms = 0) {
+            Uint64 until = SDL_GetTicks64() + _ms;
+            Uint64 current = awakeUntilTick.load(std::memory_order_relaxed);
+            while (current < until && !awakeUntilTick.compare_exchange_weak(current, until, std::memory_order_relaxed));
+        }
+
+        // Ends an idle wait early, e.g. when the simulation thread has published a new snapshot
+        static void Wake() {
+            SDL_Event event {};
+            event.type = SDL_USEREVENT;
+            SDL_PushEvent(&event);
+        }
+
+        void StartFrame() {
+            frameStartTick = SDL_GetTicks64();
+        }
+
+        void EndFrame() {
+            if (mode == Mode::VSYNC) return;
+
+            // sleep out the rest of the frame
+            Uint64 frameTime = SDL_GetTicks64() - frameStartTick;
+            if (frameTime < frameLength) SDL_Delay(Uint32(frameLength - frameTime));
+
+            // nothing to animate, wait for input. The event is left in the queue for HandleEvents
+            if (mode == Mode::IDLE && SDL_GetTicks64() >= awakeUntilTick) {
+                SDL_WaitEventTimeout(nullptr, idleTimeout);
+            }
+        }
+};
+inline FramePacer framePacer;
+
+#endif //CHESS_WITH_SDL_FRAMEPACER_H
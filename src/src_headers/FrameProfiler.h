@@ -0,0 +1,87 @@
+//
+// Created by cew05 on 19/10/2026.
+//
+
+#ifndef CHESS_WITH_SDL_FRAMEPROFILER_H
+#define CHESS_WITH_SDL_FRAMEPROFILER_H
+
+#include <array>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <SDL.h>
+
+/*
+ * Per phase frame timings. Scopes push {frame, phase, microseconds} samples into a fixed size lock-free ring buffer, so
+ * timing costs a counter read and one atomic increment. The overlay and CSV export read the most recent samples back.
+ */
+
+enum class ProfilePhase : int {
+        FRAME, DISPLAY, HANDLE_EVENTS, UPDATE_BUTTONS, CHECK_BUTTONS, TEXTURES, MOVE_GENERATION, ENGINE_WAIT,
+        PHASE_COUNT,
+};
+
+class FrameProfiler {
+    private:
+        struct Sample {
+            // sequence is written last, a reader discards a slot whose sequence does not match its index
+            std::atomic<uint64_t> sequence {UINT64_MAX};
+            uint32_t frame = 0;
+            ProfilePhase phase = ProfilePhase::FRAME;
+            uint32_t micros = 0;
+        };
+
+        static const int capacity = 1 << 14;
+        std::array<Sample, capacity> samples {};
+        std::atomic<uint64_t> head {0};
+        std::atomic<uint32_t> frame {0};
+
+        bool showOverlay = false;
+        std::string csvPath = "../RequiredFiles/FrameProfile.csv";
+
+        struct SampleCopy {
+            uint32_t frame;
+            ProfilePhase phase;
+            uint32_t micros;
+        };
+        std::vector<SampleCopy> Snapshot(int _maxSamples);
+
+    public:
+        static const char* PhaseName(ProfilePhase _phase);
+
+        void Record(ProfilePhase _phase, uint64_t _micros);
+        void NextFrame() { frame.fetch_add(1, std::memory_order_relaxed); };
+
+        // Percentile (0-100) in microseconds of the recent samples of a phase
+        std::array<uint32_t, 2> FetchP50P99(ProfilePhase _phase);
+
+        void ToggleOverlay() { showOverlay = !showOverlay; };
+        void DisplayOverlay();
+
+        void SetCSVPath(const std::string& _path) { csvPath = _path; };
+        bool ExportCSV();
+};
+inline FrameProfiler frameProfiler;
+
+/*
+ * RAII timer for one phase, e.g. ProfileScope scope(ProfilePhase::DISPLAY);
+ */
+
+class ProfileScope {
+    private:
+        ProfilePhase phase;
+        Uint64 start;
+
+    public:
+        explicit ProfileScope(ProfilePhase _phase) : phase(_phase), start(SDL_GetPerformanceCounter()) {};
+        ~ProfileScope() {
+            Uint64 elapsed = SDL_GetPerformanceCounter() - start;
+            frameProfiler.Record(phase, elapsed * 1000000 / SDL_GetPerformanceFrequency());
+        }
+
+        ProfileScope(const ProfileScope&) = delete;
+        ProfileScope& operator=(const ProfileScope&) = delete;
+};
+
+#endif //CHESS_WITH_SDL_FRAMEPROFILER_H
@@ -9,6 +9,9 @@
 #include <fstream>
 #include "GlobalSource.h"
 #include "ResourceManagers.h"
+#include "FlatManager.h"
+#include "FontCache.h"
+#include "TextureLoader.h"
 
 /*
  * GLOBAL const vars used in setting enum values
@@ -40,10 +43,28 @@ enum TextureID : int{
         MOVE = WHITE_KING + NUM_PIECE_TEXTURES*PIECE_STYLES_MAX, CAPTURE, SELECTED,
 
         // ButtonTexture Sheets
-        BUTTON_SHEET, MENU_SHEET
+        BUTTON_SHEET, MENU_SHEET,
+
+        // Atlas of the current piece style, move markers and a solid cell for tinted quads
+        PIECE_ATLAS,
 };
 
+/*
+ * Cells of the PIECE_ATLAS texture. Piece cells follow the WHITE_KING ... BLACK_PAWN order.
+ */
+
+inline const int ATLAS_CELL_SIZE = 256, ATLAS_GRID = 4, ATLAS_PADDING = 2;
+enum AtlasCell : int {
+        ATLAS_PIECES = 0,
+        ATLAS_MOVE = NUM_PIECE_TEXTURES, ATLAS_CAPTURE, ATLAS_SELECTED, ATLAS_SOLID,
+};
+
+// Bumped each time PIECE_ATLAS is recreated, batches composed from an older atlas must be recomposed
+inline int PIECE_ATLAS_VERSION = 0;
+
 inline TextureManager* tm;
+inline FontCache* fontCache;
+inline TextureLoader* textureLoader;
 
 /*
  * Enums for GLOBAL FontManager
@@ -63,6 +84,11 @@ inline std::pair<std::string, TextureID> PIECE_STYLE {};
 inline std::pair<std::string, TextureID> BOARD_STYLES[BOARD_STYLES_MAX] {};
 inline std::pair<std::string, TextureID> BOARD_STYLE {};
 
+// Styles are only decoded once selected
+inline int PIECE_STYLE_COUNT = 0, BOARD_STYLE_COUNT = 0;
+inline bool PIECE_STYLE_LOADED[PIECE_STYLES_MAX] {};
+inline bool BOARD_STYLE_LOADED[BOARD_STYLES_MAX] {};
+
 //...
 //...
 //...
@@ -75,6 +101,11 @@ inline std::pair<std::string, TextureID> BOARD_STYLE {};
 
 bool InitFonts();
 bool InitTextures();
+bool LoadBoardStyle(int _style);
+bool LoadPieceStyle(int _style);
+bool CreatePieceAtlas();
+SDL_Rect GetAtlasRect(int _cell);
+int GetPieceAtlasCell(TextureID _textureID);
 
 /*
  * GLOBAL functions to detect and construct CONFIG files
@@ -82,8 +113,11 @@ bool InitTextures();
 
 bool ConfigExists();
 
+std::string FetchConfigValue(const std::string& _key, const std::string& _default);
+int FetchConfigValue(const std::string& _key, int _default);
+
 bool PieceLayoutsExists();
 
-bool SetStyles();
+bool SetStyles(int _boardStyle = 0, int _pieceStyle = 0);
 
 #endif //CHESS_WITH_SDL_GLOBALRESOURCES_H
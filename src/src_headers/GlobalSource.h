@@ -11,6 +11,10 @@
 #include <ctime>
 #include <SDL.h>
 
+#include "FramePacer.h"
+#include "RebuildQueue.h"
+#include "FrameProfiler.h"
+
 /*
  * Main Definitions
  */
@@ -43,20 +47,28 @@ class Mouse {
         bool active = false;
         bool prevactive = false;
         bool heldactive = false;
+        std::pair<int, int> nextPosition {};
         std::pair<int, int> position {};
+        Uint64 sample = 0;
 
     public:
         void MouseDown(bool _isDown) {
             nextActive = _isDown;
         }
 
+        // Position is taken from mouse events, and only applied once per frame in Update
+        void MoveTo(int _x, int _y) {
+            nextPosition = {_x, _y};
+        }
+
         void Update() {
             // Update click values
             prevactive = active;
             active = nextActive;
             heldactive = (prevactive && active);
 
-            UpdatePosition();
+            position = nextPosition;
+            sample++;
         }
 
         void PrintStates() {
@@ -65,29 +77,31 @@ class Mouse {
         }
 
         void UpdatePosition() {
-            // Update position
-            SDL_GetMouseState(&position.first, &position.second);
+            // Resync with SDL, e.g. after the mouse re-enters the window
+            SDL_GetMouseState(&nextPosition.first, &nextPosition.second);
+            position = nextPosition;
+            sample++;
         }
 
         std::pair<int, int> GetMousePosition() { return position; }
 
+        // Changes whenever the sampled mouse state changes, so per frame results can be cached against it
+        [[nodiscard]] Uint64 GetSample() const { return sample; }
+
         bool InRadius(std::pair<int, int> pos, int radius) {
-            UpdatePosition();
-            return (std::pow(position.first - pos.first, 2) + std::pow(position.second - pos.second, 2) <= std::pow(radius, 2));
+            int dx = position.first - pos.first, dy = position.second - pos.second;
+            return dx * dx + dy * dy <= radius * radius;
         }
 
         bool InRect(SDL_Rect rect) {
-            UpdatePosition();
             return abs(position.first - (rect.x + rect.w / 2)) <= rect.w / 2 && abs(position.second - (rect.y + rect.h / 2)) <= rect.h / 2;
         }
 
         bool UnheldClick(SDL_Rect rect) {
-            UpdatePosition();
             return active && !heldactive && InRect(rect);
         }
 
         bool ClickOnRelease(SDL_Rect rect) {
-            UpdatePosition();
             return !active && prevactive && InRect(rect);
         }
 
@@ -98,7 +112,12 @@ class Mouse {
         bool IsUnheldActive() const {
             return active && !prevactive;
         }
+
+        bool IsReleased() const {
+            return !active && prevactive;
+        }
 };
-inline Mouse mouse;
+// Each thread samples its own mouse, the simulation thread is handed a copy of the main thread's mouse per tick
+inline thread_local Mouse mouse;
 
 #endif //CHESS_WITH_SDL_GLOBALSOURCE_H
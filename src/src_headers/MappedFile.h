@@ -0,0 +1,47 @@
+//
+// Created by cew05 on 19/10/2026.
+//
+
+#ifndef CHESS_WITH_SDL_MAPPEDFILE_H
+#define CHESS_WITH_SDL_MAPPEDFILE_H
+
+#include <string>
+#include <cstdint>
+#include <cstdio>
+#include <algorithm>
+
+/*
+ * Owns a memory mapped view of a file. Read only views are shared between processes; read write views create or
+ * extend the file to the requested size first.
+ */
+
+class MappedFile {
+    private:
+        // Native handles are kept opaque so that platform headers stay out of this one. file is a HANDLE on windows,
+        // where -1 is INVALID_HANDLE_VALUE, and a descriptor elsewhere. mapping is only used on windows
+        intptr_t file = -1;
+        void* mapping = nullptr;
+        unsigned char* view = nullptr;
+        uint64_t size = 0;
+        bool writable = false;
+
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        // Opening / closing
+        bool OpenRead(const std::string& _path);
+        bool OpenReadWrite(const std::string& _path, uint64_t _size);
+        bool Flush();
+        void Close();
+
+        // Getters
+        [[nodiscard]] bool IsOpen() const { return view != nullptr; };
+        [[nodiscard]] uint64_t Size() const { return size; };
+        [[nodiscard]] const unsigned char* Data() const { return view; };
+        [[nodiscard]] unsigned char* MutableData() { return writable ? view : nullptr; };
+};
+
+#endif //CHESS_WITH_SDL_MAPPEDFILE_H
@@ -0,0 +1,67 @@
+//
+// Created by cew05 on 19/10/2026.
+//
+
+#ifndef CHESS_WITH_SDL_REBUILDQUEUE_H
+#define CHESS_WITH_SDL_REBUILDQUEUE_H
+
+#include <deque>
+#include <functional>
+#include <algorithm>
+#include <SDL.h>
+
+/*
+ * Debounces texture rebuilds after a resize. Resizes only restart the settle timer; once the window has kept its size
+ * for settleMs the screen queues its rebuild jobs, which are then run a few per frame within budgetMs. Until then the
+ * old textures are drawn scaled to the new rects.
+ */
+
+class TextureRebuildQueue {
+    private:
+        std::deque<std::function<bool()>> jobs {};
+        bool pending = false;
+        Uint64 lastResizeTick = 0;
+
+        Uint64 settleMs = 150;
+        double budgetMs = 4;
+
+    public:
+        void SetSettleTime(int _ms) { settleMs = Uint64(std::max(_ms, 0)); };
+        void SetBudget(double _ms) { budgetMs = std::max(_ms, 0.0); };
+        [[nodiscard]] Uint64 GetSettleTime() const { return settleMs; };
+
+        // Discard any half finished rebuild, it was for the previous size
+        void NotifyResize() {
+            jobs.clear();
+            pending = true;
+            lastResizeTick = SDL_GetTicks64();
+        }
+
+        // True once per settled resize, the caller then queues its jobs
+        bool Settled() {
+            if (!pending || SDL_GetTicks64() - lastResizeTick < settleMs) return false;
+            pending = false;
+            return true;
+        }
+
+        void Push(std::function<bool()> _job) { jobs.push_back(std::move(_job)); };
+
+        void Run() {
+            // always make progress, even if a single job is over budget
+            Uint64 start = SDL_GetPerformanceCounter();
+            auto budgetCounts = Uint64(budgetMs / 1000.0 * (double)SDL_GetPerformanceFrequency());
+
+            while (!jobs.empty()) {
+                std::function<bool()> job = std::move(jobs.front());
+                jobs.pop_front();
+                job();
+
+                if (SDL_GetPerformanceCounter() - start >= budgetCounts) break;
+            }
+        }
+
+        [[nodiscard]] bool IsBusy() const { return pending || !jobs.empty(); };
+};
+inline TextureRebuildQueue rebuildQueue;
+
+#endif //CHESS_WITH_SDL_REBUILDQUEUE_H
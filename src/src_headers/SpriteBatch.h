@@ -0,0 +1,36 @@
+//
+// Created by cew05 on 19/10/2026.
+//
+
+#ifndef CHESS_WITH_SDL_SPRITEBATCH_H
+#define CHESS_WITH_SDL_SPRITEBATCH_H
+
+#include <vector>
+#include <SDL.h>
+
+/*
+ * Collects textured quads from a single texture (an atlas) and submits them with one SDL_RenderGeometry call. Quads
+ * are drawn in the order they were added.
+ */
+
+class SpriteBatch {
+    private:
+        SDL_Texture* texture = nullptr;
+        int textureW = 1, textureH = 1;
+
+        std::vector<SDL_Vertex> vertices {};
+        std::vector<int> indices {};
+
+    public:
+        void Begin(SDL_Texture* _texture);
+        void Add(const SDL_Rect& _srcRect, const SDL_Rect& _destRect, SDL_Color _colour = {255, 255, 255, 255});
+        bool Flush();
+
+        // Draw without clearing, so a batch composed once can be redrawn each frame
+        [[nodiscard]] bool Draw() const;
+        void Clear();
+
+        [[nodiscard]] size_t QuadCount() const { return vertices.size() / 4; };
+};
+
+#endif //CHESS_WITH_SDL_SPRITEBATCH_H
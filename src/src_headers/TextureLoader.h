@@ -0,0 +1,57 @@
+//
+// Created by cew05 on 19/10/2026.
+//
+
+#ifndef CHESS_WITH_SDL_TEXTURELOADER_H
+#define CHESS_WITH_SDL_TEXTURELOADER_H
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <SDL.h>
+
+#include "ResourceManagers.h"
+
+/*
+ * Decodes PNGs on a pool of worker threads. Workers only produce SDL_Surfaces; the renderer is not thread safe, so
+ * textures are created from the surfaces on the main thread by Upload and handed to the TextureManager.
+ */
+
+class TextureLoader {
+    private:
+        struct Request {
+            std::string path;
+            int textureID = 0;
+            SDL_Surface* surface = nullptr;
+        };
+
+        std::vector<std::thread> workers {};
+        std::mutex queueMutex;
+        std::condition_variable queueCondition;
+        std::condition_variable doneCondition;
+
+        std::deque<Request> requests {};
+        std::deque<Request> decoded {};
+        int inFlight = 0;
+        bool stopping = false;
+
+        void WorkerLoop();
+
+    public:
+        explicit TextureLoader(int _workers = 0);
+        ~TextureLoader();
+
+        // Queue a decode, the texture must already be registered with the TextureManager under _textureID
+        void Queue(const std::string& _path, int _textureID);
+
+        // Main thread only. Uploads decoded surfaces, returns the number of textures uploaded
+        int Upload(TextureManager* _tm, int _maxUploads = -1);
+        void Finish(TextureManager* _tm);
+
+        [[nodiscard]] bool IsIdle();
+};
+
+#endif //CHESS_WITH_SDL_TEXTURELOADER_H
@@ -0,0 +1,46 @@
+//
+// Created by cew05 on 19/10/2026.
+//
+
+#ifndef CHESS_WITH_SDL_TRIPLEBUFFER_H
+#define CHESS_WITH_SDL_TRIPLEBUFFER_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/*
+ * Lock free single producer / single consumer triple buffer. The producer fills WriteBuffer and publishes it, swapping
+ * it with the shared middle buffer; the consumer swaps the middle buffer for its read buffer when a newer one has been
+ * published. Neither side waits, the consumer simply keeps reading the last buffer it took. The write buffer holds stale
+ * data after Publish, so the producer must refill it completely.
+ */
+
+template<class T>
+class TripleBuffer {
+    private:
+        std::array<T, 3> buffers {};
+
+        // index of the middle buffer, FRESH is set while it holds data the consumer has not taken
+        static constexpr uint8_t FRESH = 4, INDEX = 3;
+        std::atomic<uint8_t> middle {1};
+        uint8_t writeIndex = 0;
+        uint8_t readIndex = 2;
+
+    public:
+        // Producer
+        T& WriteBuffer() { return buffers[writeIndex]; };
+        void Publish() {
+            writeIndex = middle.exchange(writeIndex | FRESH, std::memory_order_acq_rel) & INDEX;
+        }
+
+        // Consumer, returns true if a newer buffer was taken
+        bool Consume() {
+            if ((middle.load(std::memory_order_relaxed) & FRESH) == 0) return false;
+            readIndex = middle.exchange(readIndex, std::memory_order_acq_rel) & INDEX;
+            return true;
+        }
+        const T& ReadBuffer() const { return buffers[readIndex]; };
+};
+
+#endif //CHESS_WITH_SDL_TRIPLEBUFFER_H